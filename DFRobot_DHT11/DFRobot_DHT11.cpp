@@ -12,6 +12,12 @@
 
 #include "DFRobot_DHT11.h"
 
+DFRobot_DHT11::DFRobot_DHT11()
+  : humidity(0), temperature(0), _pin(0), _temperatureDeci(0), _humidityDeci(0),
+    _status(DHT11_ERROR_NOT_STARTED), _busy(false), _hasRead(false), _startUs(0), _lastReadMs(0)
+{
+}
+
 void DFRobot_DHT11::read(int pin)
 {
     uint8_t bits[5];
@@ -66,3 +72,139 @@ void DFRobot_DHT11::read(int pin)
     humidity    = bits[0]; 
     temperature = bits[2]; 
 }
+
+bool DFRobot_DHT11::startRead(int pin)
+{
+  if (_busy) {
+    return false;
+  }
+  if (_hasRead && millis() - _lastReadMs < DHT11_MIN_INTERVAL) {
+    return false;
+  }
+  _pin = pin;
+  _busy = true;
+  _hasRead = true;
+  _lastReadMs = millis();
+  pinMode(_pin, OUTPUT);
+  digitalWrite(_pin, LOW);
+  _startUs = micros();
+  return true;
+}
+
+int8_t DFRobot_DHT11::poll(void)
+{
+  if (!_busy) {
+    return _hasRead ? _status : DHT11_ERROR_NOT_STARTED;
+  }
+  if (micros() - _startUs < DHT11_START_MS * 1000UL) {
+    return DHT11_BUSY;
+  }
+  _status = receive();
+  _busy = false;
+  return _status;
+}
+
+int8_t DFRobot_DHT11::readSensor(int pin)
+{
+  if (!startRead(pin)) {
+    if (!_busy) {
+      return _status;  // read less than DHT11_MIN_INTERVAL ago
+    }
+  }
+  int8_t status;
+  while ((status = poll()) == DHT11_BUSY) {
+    yield();
+  }
+  return status;
+}
+
+/**
+ * Wait while the line is at the given level
+ * @return time at that level in us, 0 on timeout
+ */
+uint32_t DFRobot_DHT11::waitLevel(uint8_t level, uint32_t timeoutUs)
+{
+  uint32_t start = micros();
+  while (digitalRead(_pin) == level) {
+    if (micros() - start > timeoutUs) {
+      return 0;
+    }
+  }
+  uint32_t t = micros() - start;
+  return t ? t : 1;
+}
+
+/**
+ * End the start signal and receive the 40 bit frame
+ */
+int8_t DFRobot_DHT11::receive(void)
+{
+  for (uint8_t i = 0; i < 5; i++) {
+    _data[i] = 0;
+  }
+  digitalWrite(_pin, HIGH);
+  pinMode(_pin, INPUT_PULLUP);
+
+  // Sensor answers after 20-40 us with 80 us low, 80 us high
+  if (!waitLevel(HIGH, 100) || !waitLevel(LOW, 120)) {
+    return DHT11_ERROR_NO_RESPONSE;
+  }
+  if (!waitLevel(HIGH, 120)) {
+    return DHT11_ERROR_NO_RESPONSE;
+  }
+
+  // Each bit: ~50 us low, then 26-28 us high (0) or 70 us high (1)
+  for (uint8_t i = 0; i < 40; i++) {
+    if (!waitLevel(LOW, 100)) {
+      return DHT11_ERROR_TIMEOUT;
+    }
+    uint32_t high = waitLevel(HIGH, 120);
+    if (!high) {
+      return DHT11_ERROR_TIMEOUT;
+    }
+    _data[i / 8] <<= 1;
+    if (high > 50) {
+      _data[i / 8] |= 1;
+    }
+  }
+
+  if (_data[4] != (uint8_t)(_data[0] + _data[1] + _data[2] + _data[3])) {
+    return DHT11_ERROR_CHECKSUM;
+  }
+
+  // Newer DHT11 send the decimal byte; bit 7 of it marks below 0 °C
+  int16_t t = _data[2];
+  if (_data[3] & 0x80) {
+    t = -1 - t;
+  }
+  _temperatureDeci = t * 10 + (_data[3] & 0x0f);
+  _humidityDeci = _data[0] * 10 + _data[1];
+  humidity = _data[0];
+  temperature = _temperatureDeci / 10;
+  return DHT11_OK;
+}
+
+int8_t DFRobot_DHT11::getStatus(void) const
+{
+  return _status;
+}
+
+float DFRobot_DHT11::getTemperature(void) const
+{
+  return _temperatureDeci * 0.1;
+}
+
+float DFRobot_DHT11::getHumidity(void) const
+{
+  return _humidityDeci * 0.1;
+}
+
+int16_t DFRobot_DHT11::getTemperatureDeci(void) const
+{
+  return _temperatureDeci;
+}
+
+int16_t DFRobot_DHT11::getHumidityDeci(void) const
+{
+  return _humidityDeci;
+}
@@ -1,4 +1,3 @@
-
 /*!
  * @file DFRobot_DHT11.h
  * @brief DHT11 is used to read the temperature and humidity of the current environment. 
@@ -19,8 +18,20 @@
 #include <WProgram.h>
 #endif
 
+#define DHT11_OK                 0   ///< valid frame, checksum correct
+#define DHT11_BUSY               1   ///< poll(): read still in progress
+#define DHT11_ERROR_NO_RESPONSE  -1  ///< sensor did not answer the start signal
+#define DHT11_ERROR_TIMEOUT      -2  ///< a bit did not arrive in time
+#define DHT11_ERROR_CHECKSUM     -3  ///< 40 bits received, checksum mismatch
+#define DHT11_ERROR_NOT_STARTED  -4  ///< poll() without startRead()
+
+#define DHT11_MIN_INTERVAL       1000  ///< ms between two bus transactions
+#define DHT11_START_MS           20    ///< start signal, at least 18 ms low
+
 class DFRobot_DHT11{
 public:
+  DFRobot_DHT11();
+
   /**
    * @fn read
    * @brief Read DHT11 data
@@ -28,7 +39,85 @@ public:
    * @return NONE    
    */
   void read(int pin);
+
+  /**
+   * @fn readSensor
+   * @brief Read DHT11 data with checksum validation. No 200 ms sleep: within
+   * @n     DHT11_MIN_INTERVAL of the last read the last result is returned
+   * @n     without bus access. Blocks for the 20 ms start signal and the
+   * @n     ~5 ms frame; all timeouts are measured with micros().
+   * @param pin: Connect the IO port of the DHT11 data port.
+   * @return DHT11_OK or a DHT11_ERROR_* code
+   */
+  int8_t readSensor(int pin);
+
+  /**
+   * @fn startRead
+   * @brief Start a non-blocking read: sends the start signal and returns.
+   * @n     Call poll() until it no longer returns DHT11_BUSY.
+   * @param pin: Connect the IO port of the DHT11 data port.
+   * @return true if started, false if busy or within DHT11_MIN_INTERVAL
+   */
+  bool startRead(int pin);
+
+  /**
+   * @fn poll
+   * @brief Advance a non-blocking read. After DHT11_START_MS it receives
+   * @n     the frame (~5 ms).
+   * @return DHT11_BUSY while waiting, then DHT11_OK or a DHT11_ERROR_* code
+   */
+  int8_t poll(void);
+
+  /**
+   * @fn getStatus
+   * @brief Result of the last completed read
+   * @return DHT11_OK or a DHT11_ERROR_* code
+   */
+  int8_t getStatus(void) const;
+
+  /**
+   * @fn getTemperature
+   * @brief Temperature of the last valid frame, with the decimal byte
+   * @return Temperature in °C
+   */
+  float getTemperature(void) const;
+
+  /**
+   * @fn getHumidity
+   * @brief Humidity of the last valid frame, with the decimal byte
+   * @return Humidity in %RH
+   */
+  float getHumidity(void) const;
+
+  /**
+   * @fn getTemperatureDeci
+   * @brief Temperature of the last valid frame in tenths (235 = 23.5 °C)
+   * @return Temperature in 0.1 °C
+   */
+  int16_t getTemperatureDeci(void) const;
+
+  /**
+   * @fn getHumidityDeci
+   * @brief Humidity of the last valid frame in tenths (652 = 65.2 %RH)
+   * @return Humidity in 0.1 %RH
+   */
+  int16_t getHumidityDeci(void) const;
+
   int humidity;
   int temperature;
+
+private:
+  int8_t receive(void);
+  uint32_t waitLevel(uint8_t level, uint32_t timeoutUs);
+
+  uint8_t _pin;
+  uint8_t _data[5];
+  int16_t _temperatureDeci;
+  int16_t _humidityDeci;
+  int8_t _status;
+  bool _busy;
+  bool _hasRead;
+  uint32_t _startUs;      // micros() when the start signal began
+  uint32_t _lastReadMs;   // millis() of the last bus transaction
 };
 #endif
@@ -0,0 +1,48 @@
+/*!
+ * @file readDHT11NonBlocking.ino
+ * @brief Read the DHT11 without blocking loop() during the 20 ms start signal,
+ * @n     with checksum validation and error reporting.
+ *
+ * @copyright   Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license     The MIT License (MIT)
+ * @author [Wuxiao](xiao.wu@dfrobot.com)
+ * @version  V1.0
+ * @date  2018-09-14
+ * @url https://github.com/DFRobot/DFRobot_DHT11
+ */
+
+#include <DFRobot_DHT11.h>
+DFRobot_DHT11 DHT;
+#define DHT11_PIN 10
+
+unsigned long lastStart = 0;
+bool reading = false;
+
+void setup(){
+  Serial.begin(115200);
+}
+
+void loop(){
+  if (!reading && millis() - lastStart >= 2000) {
+    reading = DHT.startRead(DHT11_PIN);
+    lastStart = millis();
+  }
+
+  if (reading) {
+    int8_t status = DHT.poll();
+    if (status != DHT11_BUSY) {
+      reading = false;
+      if (status == DHT11_OK) {
+        Serial.print("temp:");
+        Serial.print(DHT.getTemperature(), 1);
+        Serial.print("  humi:");
+        Serial.println(DHT.getHumidity(), 1);
+      } else {
+        Serial.print("read error: ");
+        Serial.println(status);
+      }
+    }
+  }
+
+  // other work runs here while the start signal is sent
+}
@@ -25,6 +25,10 @@
 
 #include "DHT.h"
 
+#if defined(ESP32)
+#include "driver/gpio.h"
+#endif
+
 #define MIN_INTERVAL 2000 /**< min interval value */
 #define TIMEOUT                                                                \
   UINT32_MAX /**< Used programmatically for timeout.                           \
@@ -38,11 +42,25 @@
  *          type of sensor
  *  @param  count
  *          number of sensors
+ *  @param  capture
+ *          DHT_CAPTURE_POLLING (default) or DHT_CAPTURE_HARDWARE
  */
-DHT::DHT(uint8_t pin, uint8_t type, uint8_t count) {
+DHT::DHT(uint8_t pin, uint8_t type, uint8_t count, DHTCapture capture) {
   (void)count; // Workaround to avoid compiler warning.
   _pin = pin;
   _type = type;
+  _asyncState = ASYNC_IDLE;
+  _asyncSince = 0;
+  _asyncWait = 0;
+  _capture = capture;
+  _lastError = DHT_OK;
+  _errorBit = 0;
+  _sampleTime = 0;
+  _maxRetries = 0;
+  _retry = 0;
+  _startRestarts = 0;
+  _retryBackoff = MIN_INTERVAL;
+  resetStats();
 #ifdef __AVR
   _bit = digitalPinToBitMask(pin);
   _port = digitalPinToPort(pin);
@@ -67,9 +85,14 @@ void DHT::begin(uint8_t usec) {
   // >= MIN_INTERVAL right away. Note that this assignment wraps around,
   // but so will the subtraction.
   _lastreadtime = millis() - MIN_INTERVAL;
+  _sampleTime = 0;
   DEBUG_PRINT("DHT max clock cycles: ");
   DEBUG_PRINTLN(_maxcycles, DEC);
   pullTime = usec;
+  if (_capture == DHT_CAPTURE_HARDWARE && !captureInit()) {
+    DEBUG_PRINTLN(F("DHT hardware capture not available, polling."));
+    _capture = DHT_CAPTURE_POLLING;
+  }
 }
 
 /*!
@@ -83,46 +106,31 @@ void DHT::begin(uint8_t usec) {
  *	@return Temperature value in selected scale
  */
 float DHT::readTemperature(bool S, bool force) {
-  float f = NAN;
-
-  if (read(force)) {
-    switch (_type) {
-    case DHT11:
-      f = data[2];
-      if (data[3] & 0x80) {
-        f = -1 - f;
-      }
-      f += (data[3] & 0x0f) * 0.1;
-      if (S) {
-        f = convertCtoF(f);
-      }
-      break;
-    case DHT12:
-      f = data[2];
-      f += (data[3] & 0x0f) * 0.1;
-      if (data[2] & 0x80) {
-        f *= -1;
-      }
-      if (S) {
-        f = convertCtoF(f);
-      }
-      break;
-    case DHT22:
-    case DHT21:
-      f = ((word)(data[2] & 0x7F)) << 8 | data[3];
-      f *= 0.1;
-      if (data[2] & 0x80) {
-        f *= -1;
-      }
-      if (S) {
-        f = convertCtoF(f);
-      }
-      break;
-    }
+  int16_t t = readTemperatureDeci(force);
+  if (t == DHT_INVALID_DECI) {
+    return NAN;
+  }
+  float f = t * 0.1;
+  if (S) {
+    f = convertCtoF(f);
   }
   return f;
 }
 
+/*!
+ *  @brief  Read temperature without floating point math
+ *  @param  force
+ *          true if in force mode
+ *  @return Temperature in tenths of a degree Celsius (e.g. 235 = 23.5 °C),
+ *          DHT_INVALID_DECI if the read failed
+ */
+int16_t DHT::readTemperatureDeci(bool force) {
+  if (!read(force)) {
+    return DHT_INVALID_DECI;
+  }
+  return dhtTemperatureDeci(data, _type);
+}
+
 /*!
  *  @brief  Converts Celcius to Fahrenheit
  *  @param  c
@@ -139,6 +147,22 @@ float DHT::convertCtoF(float c) { return c * 1.8 + 32; }
  */
 float DHT::convertFtoC(float f) { return (f - 32) * 0.55555; }
 
+/*!
+ *  @brief  Converts tenths of a degree Celsius to tenths of a degree
+ *          Fahrenheit, rounded to nearest
+ *  @param  c
+ *          value in 0.1 °C
+ *  @return value in 0.1 °F (DHT_INVALID_DECI stays invalid)
+ */
+int16_t DHT::convertDeciCtoF(int16_t c) {
+  if (c == DHT_INVALID_DECI) {
+    return DHT_INVALID_DECI;
+  }
+  int32_t f = (int32_t)c * 9;
+  f = (f >= 0 ? f + 2 : f - 2) / 5;
+  return (int16_t)(f + 320);
+}
+
 /*!
  *  @brief  Read Humidity
  *  @param  force
@@ -146,21 +170,25 @@ float DHT::convertFtoC(float f) { return (f - 32) * 0.55555; }
  *	@return float value - humidity in percent
  */
 float DHT::readHumidity(bool force) {
-  float f = NAN;
-  if (read(force)) {
-    switch (_type) {
-    case DHT11:
-    case DHT12:
-      f = data[0] + data[1] * 0.1;
-      break;
-    case DHT22:
-    case DHT21:
-      f = ((word)data[0]) << 8 | data[1];
-      f *= 0.1;
-      break;
-    }
+  int16_t h = readHumidityDeci(force);
+  if (h == DHT_INVALID_DECI) {
+    return NAN;
   }
-  return f;
+  return h * 0.1;
+}
+
+/*!
+ *  @brief  Read humidity without floating point math
+ *  @param  force
+ *          force read mode
+ *  @return Humidity in tenths of a percent (e.g. 652 = 65.2 %RH),
+ *          DHT_INVALID_DECI if the read failed
+ */
+int16_t DHT::readHumidityDeci(bool force) {
+  if (!read(force)) {
+    return DHT_INVALID_DECI;
+  }
+  return dhtHumidityDeci(data, _type);
 }
 
 /*!
@@ -177,6 +205,38 @@ float DHT::computeHeatIndex(bool isFahrenheit) {
   return hi;
 }
 
+// Comfort index kernels. Single precision throughout (an ESP32 has an FPU
+// for float only) and branch-free, so the batch loops below can be
+// auto-vectorised on a host.
+
+// Heat index in °F: Steadman's simple formula, or the Rothfusz regression
+// above 79 °F. The regression is evaluated as a polynomial in T whose
+// coefficients are polynomials in RH (Horner form, no pow()).
+static inline float heatIndexF(float t, float rh) {
+  float simple = 0.5f * (t + 61.0f + ((t - 68.0f) * 1.2f) + (rh * 0.094f));
+
+  float a0 = -42.379f + rh * (10.14333127f + rh * -0.05481717f);
+  float a1 = 2.04901523f + rh * (-0.22475541f + rh * 0.00085282f);
+  float a2 = -0.00683783f + rh * (0.00122874f + rh * -0.00000199f);
+  float hi = a0 + t * (a1 + t * a2);
+
+  bool dry = (rh < 13.0f) && (t >= 80.0f) && (t <= 112.0f);
+  bool humid = (rh > 85.0f) && (t >= 80.0f) && (t <= 87.0f);
+  float span = (17.0f - fabsf(t - 95.0f)) * 0.05882f;
+  float root = sqrtf(span > 0.0f ? span : 0.0f);
+  hi -= dry ? ((13.0f - rh) * 0.25f) * root : 0.0f;
+  hi += humid ? ((rh - 85.0f) * 0.1f) * ((87.0f - t) * 0.2f) : 0.0f;
+
+  return (simple > 79.0f) ? hi : simple;
+}
+
+// Dew point in °C, Magnus formula (b = 17.62, c = 243.12 °C; accurate to
+// about 0.1 °C between -45 and 60 °C). NAN for 0 %RH.
+static inline float dewPointC(float t, float rh) {
+  float gamma = logf(rh * 0.01f) + (17.62f * t) / (243.12f + t);
+  return (243.12f * gamma) / (17.62f - gamma);
+}
+
 /*!
  *  @brief  Compute Heat Index
  *  				Using both Rothfusz and Steadman's equations
@@ -191,44 +251,160 @@ float DHT::computeHeatIndex(bool isFahrenheit) {
  */
 float DHT::computeHeatIndex(float temperature, float percentHumidity,
                             bool isFahrenheit) {
-  float hi;
-
-  if (!isFahrenheit)
-    temperature = convertCtoF(temperature);
-
-  hi = 0.5 * (temperature + 61.0 + ((temperature - 68.0) * 1.2) +
-              (percentHumidity * 0.094));
+  if (isFahrenheit) {
+    return heatIndexF(temperature, percentHumidity);
+  }
+  return (heatIndexF(temperature * 1.8f + 32.0f, percentHumidity) - 32.0f) *
+         0.55555f;
+}
 
-  if (hi > 79) {
-    hi = -42.379 + 2.04901523 * temperature + 10.14333127 * percentHumidity +
-         -0.22475541 * temperature * percentHumidity +
-         -0.00683783 * pow(temperature, 2) +
-         -0.05481717 * pow(percentHumidity, 2) +
-         0.00122874 * pow(temperature, 2) * percentHumidity +
-         0.00085282 * temperature * pow(percentHumidity, 2) +
-         -0.00000199 * pow(temperature, 2) * pow(percentHumidity, 2);
+/*!
+ *  @brief  Compute Heat Index without floating point math
+ *  @param  temperature
+ *          temperature in 0.1 °C
+ *  @param  percentHumidity
+ *          humidity in 0.1 %
+ *  @return heat index in 0.1 °C (within 0.1 °C of computeHeatIndex())
+ */
+int16_t DHT::computeHeatIndexDeci(int16_t temperature,
+                                  int16_t percentHumidity) {
+  // Work in 0.01 °F (exact for 0.1 °C input) and 0.1 %RH
+  int32_t t = (int32_t)temperature * 18 + 3200;
+  int32_t rh = percentHumidity;
+  // Steadman's formula, times 20000
+  int32_t simple = 100 * t + 610000 + 120 * (t - 6800) + 94 * rh;
+  int32_t hi; // 0.01 °F
+
+  if (simple > 1580000) {
+    // Rothfusz regression scaled by 1e14, coefficients pre-divided by the
+    // powers of ten of the units so all of them are exact integers
+    int64_t a0 = -4237900000000000LL +
+                 rh * (101433312700000LL + rh * -54817170000LL);
+    int64_t a1 = 2049015230000LL + rh * (-22475541000LL + rh * 8528200LL);
+    int64_t a2 = -68378300LL + rh * (1228740LL + rh * -199LL);
+    int64_t q = a0 + t * (a1 + t * a2);
+    hi = (int32_t)((q + (q >= 0 ? 500000000000LL : -500000000000LL)) /
+                   1000000000000LL);
+
+    if (rh < 130 && t >= 8000 && t <= 11200) {
+      // (13 - RH) / 4 * sqrt((17 - |T - 95|) / 17)
+      int32_t d = 1700 - abs((int)(t - 9500));
+      uint32_t v = (uint32_t)d * 10000UL / 17; // d / 1700 * 1e6
+      uint32_t root = 0; // isqrt: sqrt(d / 1700) * 1000
+      uint32_t bit = 1UL << 30;
+      while (bit > v) {
+        bit >>= 2;
+      }
+      for (; bit != 0; bit >>= 2) {
+        if (v >= root + bit) {
+          v -= root + bit;
+          root = (root >> 1) + bit;
+        } else {
+          root >>= 1;
+        }
+      }
+      hi -= (int32_t)(((130 - rh) * root + 200) / 400);
+    } else if (rh > 850 && t >= 8000 && t <= 8700) {
+      // (RH - 85) / 10 * (87 - T) / 5
+      hi += ((rh - 850) * (8700 - t) + 250) / 500;
+    }
+  } else {
+    hi = (simple + 100) / 200;
+  }
+  // Back to 0.1 °C, rounded
+  int32_t c = hi - 3200;
+  return (int16_t)((c >= 0 ? c + 9 : c - 9) / 18);
+}
 
-    if ((percentHumidity < 13) && (temperature >= 80.0) &&
-        (temperature <= 112.0))
-      hi -= ((13.0 - percentHumidity) * 0.25) *
-            sqrt((17.0 - abs(temperature - 95.0)) * 0.05882);
+/*!
+ *  @brief  Compute Dew Point (Magnus formula)
+ *  @param  temperature
+ *          temperature in selected scale
+ *  @param  percentHumidity
+ *          humidity in percent
+ *  @param  isFahrenheit
+ * 					true if fahrenheit, false if celcius
+ *	@return dew point in the selected scale, NAN at 0 %
+ */
+float DHT::computeDewPoint(float temperature, float percentHumidity,
+                           bool isFahrenheit) {
+  if (isFahrenheit) {
+    float td = dewPointC((temperature - 32.0f) * 0.55555f, percentHumidity);
+    return td * 1.8f + 32.0f;
+  }
+  return dewPointC(temperature, percentHumidity);
+}
 
-    else if ((percentHumidity > 85.0) && (temperature >= 80.0) &&
-             (temperature <= 87.0))
-      hi += ((percentHumidity - 85.0) * 0.1) * ((87.0 - temperature) * 0.2);
+/*!
+ *  @brief  Compute the heat index of many readings, e.g. a log. The loop
+ *          has no branches, so compilers can vectorise it.
+ *  @param  temperature
+ *          temperatures in the selected scale
+ *  @param  percentHumidity
+ *          humidities in percent
+ *  @param  out
+ *          receives the heat indices (may be the temperature array)
+ *  @param  count
+ *          number of readings
+ *  @param  isFahrenheit
+ * 					true if fahrenheit, false if celcius
+ */
+void DHT::computeHeatIndexBatch(const float *temperature,
+                                const float *percentHumidity, float *out,
+                                size_t count, bool isFahrenheit) {
+  if (isFahrenheit) {
+    for (size_t i = 0; i < count; i++) {
+      out[i] = heatIndexF(temperature[i], percentHumidity[i]);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      float hi = heatIndexF(temperature[i] * 1.8f + 32.0f, percentHumidity[i]);
+      out[i] = (hi - 32.0f) * 0.55555f;
+    }
   }
+}
 
-  return isFahrenheit ? hi : convertFtoC(hi);
+/*!
+ *  @brief  Compute the dew point of many readings
+ *  @param  temperature
+ *          temperatures in the selected scale
+ *  @param  percentHumidity
+ *          humidities in percent
+ *  @param  out
+ *          receives the dew points (may be the temperature array)
+ *  @param  count
+ *          number of readings
+ *  @param  isFahrenheit
+ * 					true if fahrenheit, false if celcius
+ */
+void DHT::computeDewPointBatch(const float *temperature,
+                               const float *percentHumidity, float *out,
+                               size_t count, bool isFahrenheit) {
+  if (isFahrenheit) {
+    for (size_t i = 0; i < count; i++) {
+      float td = dewPointC((temperature[i] - 32.0f) * 0.55555f,
+                           percentHumidity[i]);
+      out[i] = td * 1.8f + 32.0f;
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      out[i] = dewPointC(temperature[i], percentHumidity[i]);
+    }
+  }
 }
 
 /*!
  *  @brief  Read value from sensor or return last one from less than two
- *seconds.
+ *seconds. While a non-blocking read is in progress the last result is
+ *returned without touching the bus, even in force mode.
  *  @param  force
  *          true if using force mode
  *	@return float value
  */
 bool DHT::read(bool force) {
+  if (isReading()) {
+    return _lastresult; // data[] still holds the frame of that result
+  }
   // Check if sensor was read less than two seconds ago and return early
   // to use last reading.
   uint32_t currenttime = millis();
@@ -249,85 +425,370 @@ bool DHT::read(bool force) {
 
   // Go into high impedence state to let pull-up raise data line level and
   // start the reading process.
-  pinMode(_pin, INPUT_PULLUP);
+  lineRelease();
   delay(1);
 
   // First set data line low for a period according to sensor type
-  pinMode(_pin, OUTPUT);
-  digitalWrite(_pin, LOW);
+  lineLow();
+  uint32_t startPulse = startPulseMicros();
+  if (startPulse >= 16000) {
+    delay(startPulse / 1000);
+  } else {
+    delayMicroseconds(startPulse);
+  }
+
+  if (_capture == DHT_CAPTURE_HARDWARE) {
+    _lastresult = readFrameHardware();
+  } else {
+    _lastresult = readFrame();
+  }
+  recordResult(_lastresult);
+  return _lastresult;
+}
+
+/*!
+ *  @brief  Read temperature and humidity from one bus transaction (or from
+ *          the cached frame if the sensor was read less than two seconds
+ *          ago, e.g. by a non-blocking read)
+ *  @param  sample
+ *          Receives both values, the status and the acquisition time
+ *  @param  force
+ *          true if using force mode
+ *  @return true if the sample is valid
+ */
+bool DHT::readSample(DHTSample &sample, bool force) {
+  bool ok = read(force);
+  sample.timestamp = _sampleTime;
+  if (ok) {
+    sample.temperature = dhtTemperatureDeci(data, _type);
+    sample.humidity = dhtHumidityDeci(data, _type);
+    sample.status = DHT_OK;
+  } else {
+    sample.temperature = DHT_INVALID_DECI;
+    sample.humidity = DHT_INVALID_DECI;
+    sample.status = _lastError;
+  }
+  return ok;
+}
+
+/*!
+ *  @brief  Length of the start pulse for the sensor type
+ *  @return Start pulse in microseconds
+ */
+uint32_t DHT::startPulseMicros() const {
   switch (_type) {
   case DHT22:
   case DHT21:
-    delayMicroseconds(1100); // data sheet says "at least 1ms"
-    break;
+    return 1100; // data sheet says "at least 1ms"
   case DHT11:
   default:
-    delay(20); // data sheet says at least 18ms, 20ms just to be safe
-    break;
+    return 20000; // data sheet says at least 18ms, 20ms just to be safe
   }
+}
 
-  uint32_t cycles[80];
-  {
-    // End the start signal by setting data line high for 40 microseconds.
-    pinMode(_pin, INPUT_PULLUP);
+/*!
+ *  @brief  Longest start pulse the sensor type still answers
+ *  @return Maximum start pulse in microseconds
+ */
+uint32_t DHT::startPulseMaxMicros() const {
+  switch (_type) {
+  case DHT22:
+  case DHT21:
+    return 20000; // data sheet: 0.8 to 20ms
+  case DHT11:
+  default:
+    return 30000; // data sheet: 18 to 30ms
+  }
+}
 
-    // Delay a moment to let sensor pull data line low.
-    delayMicroseconds(pullTime);
+/*!
+ *  @brief  Start a non-blocking read. The start pulse is timed by poll(),
+ *          so the caller never waits inside the library. poll() ends the
+ *          start pulse, so it must come again before the sensor's maximum:
+ *          at least every 18 ms for a DHT21/22 (1.1 to 20 ms pulse) and
+ *          every 10 ms for a DHT11 (20 to 30 ms). A later poll() resends
+ *          the start pulse (DHT_START_RESTARTS times, then the attempt
+ *          fails with DHT_ERROR_START_OVERRUN).
+ *  @param  force
+ *          true to ignore the minimum interval between reads
+ *  @return true if a read was started, false if one is already running or
+ *          the sensor was read less than two seconds ago
+ */
+bool DHT::startRead(bool force) {
+  if (isReading()) {
+    return false;
+  }
+  uint32_t currenttime = millis();
+  if (!force && ((currenttime - _lastreadtime) < MIN_INTERVAL)) {
+    return false;
+  }
+  _retry = 0;
+  startPullup();
+  return true;
+}
 
-    // Now start reading the data line to get the value from the DHT sensor.
+/*!
+ *  @brief  First step of a non-blocking read: release the line and let the
+ *          pull-up raise it before the start pulse
+ */
+void DHT::startPullup() {
+  _lastreadtime = millis();
+
+  // data[] is not cleared: it keeps the last frame, which read() and
+  // readSample() report until this read finishes. The new frame is only
+  // written inside poll(), together with _lastresult.
+
+  _startRestarts = 0;
+  lineRelease();
+  _asyncSince = micros();
+  _asyncWait = 1000;
+  _asyncState = ASYNC_PULLUP;
+}
 
-    // Turn off interrupts temporarily because the next sections
-    // are timing critical and we don't want any interruptions.
-    InterruptLock lock;
+/*!
+ *  @brief  Advance a read started with startRead(). Call it often (every
+ *          loop()); the start pulse ends on the first call after its
+ *          deadline, then the frame is captured and checked. If that call
+ *          comes after the sensor's maximum start pulse (20 ms for a
+ *          DHT21/22, 30 ms for a DHT11), the line is released and the start
+ *          pulse is sent again instead.
+ *  @return true while the read is still in progress
+ */
+bool DHT::poll() {
+  if (!isReading()) {
+    return false;
+  }
 
-    // First expect a low signal for ~80 microseconds followed by a high signal
-    // for ~80 microseconds again.
-    if (expectPulse(LOW) == TIMEOUT) {
-      DEBUG_PRINTLN(F("DHT timeout waiting for start signal low pulse."));
+  if (_asyncState == ASYNC_CAPTURE) {
+    // Hardware records the edges, just check for the end of the frame
+    if (captureDone()) {
+      _lastresult = captureFinish();
+    } else if (micros() - _asyncSince >= _asyncWait) {
+      DEBUG_PRINTLN(F("DHT timeout waiting for hardware capture."));
+      captureStop();
       _lastresult = false;
-      return _lastresult;
-    }
-    if (expectPulse(HIGH) == TIMEOUT) {
-      DEBUG_PRINTLN(F("DHT timeout waiting for start signal high pulse."));
-      _lastresult = false;
-      return _lastresult;
+    } else {
+      return true;
     }
+    return finishAsync();
+  }
 
-    // Now read the 40 bits sent by the sensor.  Each bit is sent as a 50
-    // microsecond low pulse followed by a variable length high pulse.  If the
-    // high pulse is ~28 microseconds then it's a 0 and if it's ~70 microseconds
-    // then it's a 1.  We measure the cycle count of the initial 50us low pulse
-    // and use that to compare to the cycle count of the high pulse to determine
-    // if the bit is a 0 (high state cycle count < low state cycle count), or a
-    // 1 (high state cycle count > low state cycle count). Note that for speed
-    // all the pulses are read into a array and then examined in a later step.
-    for (int i = 0; i < 80; i += 2) {
-      cycles[i] = expectPulse(LOW);
-      cycles[i + 1] = expectPulse(HIGH);
+  if (micros() - _asyncSince < _asyncWait) {
+    return true;
+  }
+
+  if (_asyncState == ASYNC_BACKOFF) {
+    startPullup();
+    return true;
+  }
+
+  if (_asyncState == ASYNC_PULLUP) {
+    // Begin the start pulse
+    lineLow();
+    _asyncSince = micros();
+    _asyncWait = startPulseMicros();
+    _asyncState = ASYNC_START;
+    return true;
+  }
+
+  // A slow loop() stretched the start pulse past what the sensor accepts:
+  // it would not answer, so release the line and start over
+  if (micros() - _asyncSince > startPulseMaxMicros()) {
+    lineRelease();
+    _stats.startOverrun++;
+    if (_startRestarts < DHT_START_RESTARTS) {
+      _startRestarts++;
+      _asyncSince = micros();
+      _asyncWait = 1000;
+      _asyncState = ASYNC_PULLUP;
+      return true;
     }
-  } // Timing critical code is now complete.
+    DEBUG_PRINTLN(F("DHT start pulse overran, poll() called too rarely."));
+    _lastError = DHT_ERROR_START_OVERRUN;
+    _lastresult = false;
+    return finishAsync();
+  }
 
-  // Inspect pulses and determine which ones are 0 (high state cycle count < low
-  // state cycle count), or 1 (high state cycle count > low state cycle count).
-  for (int i = 0; i < 40; ++i) {
-    uint32_t lowCycles = cycles[2 * i];
-    uint32_t highCycles = cycles[2 * i + 1];
-    if ((lowCycles == TIMEOUT) || (highCycles == TIMEOUT)) {
-      DEBUG_PRINTLN(F("DHT timeout waiting for pulse."));
-      _lastresult = false;
-      return _lastresult;
+  // Start pulse is long enough, read the answer
+  if (_capture == DHT_CAPTURE_HARDWARE) {
+    captureStart();
+    _asyncSince = micros();
+    _asyncWait = DHT_CAPTURE_TIMEOUT_US;
+    _asyncState = ASYNC_CAPTURE;
+    return true;
+  }
+  _lastresult = readFrame();
+  return finishAsync();
+}
+
+/*!
+ *  @brief  Account a finished non-blocking attempt and either schedule a
+ *          retry or report the result
+ *  @return true if a retry is pending (read still in progress)
+ */
+bool DHT::finishAsync() {
+  recordResult(_lastresult);
+  if (!_lastresult && _retry < _maxRetries) {
+    // Exponential backoff, never below the sensor's 2 s minimum interval
+    uint32_t wait = _retryBackoff << _retry;
+    if (wait < MIN_INTERVAL) {
+      wait = MIN_INTERVAL;
     }
-    data[i / 8] <<= 1;
-    // Now compare the low and high cycle times to see if the bit is a 0 or 1.
-    if (highCycles > lowCycles) {
-      // High cycles are greater than 50us low cycle count, must be a 1.
-      data[i / 8] |= 1;
+    if (wait > DHT_MAX_BACKOFF) {
+      wait = DHT_MAX_BACKOFF;
     }
-    // Else high cycles are less than (or equal to, a weird case) the 50us low
-    // cycle count so this must be a zero.  Nothing needs to be changed in the
-    // stored data.
+    _retry++;
+    _stats.retries++;
+    _asyncSince = micros();
+    _asyncWait = wait * 1000;
+    _asyncState = ASYNC_BACKOFF;
+    return true;
+  }
+  _asyncState = ASYNC_DONE;
+  return false;
+}
+
+/*!
+ *  @brief  Check once whether a non-blocking read has finished. Afterwards
+ *          readTemperature() and readHumidity() return the new values
+ *          (without another bus transaction) for the next two seconds.
+ *  @return true once per completed read, successful or not
+ */
+bool DHT::resultReady() {
+  if (_asyncState != ASYNC_DONE) {
+    return false;
+  }
+  _asyncState = ASYNC_IDLE;
+  return true;
+}
+
+/*!
+ *  @brief  Check whether a non-blocking read is in progress
+ *  @return true between startRead() and the end of the frame
+ */
+bool DHT::isReading() const {
+  return _asyncState == ASYNC_PULLUP || _asyncState == ASYNC_START ||
+         _asyncState == ASYNC_CAPTURE || _asyncState == ASYNC_BACKOFF;
+}
+
+/*!
+ *  @brief  Get the reason of the last failed read
+ *  @return DHT_OK if the last read succeeded
+ */
+DHTError DHT::getLastError() const { return _lastError; }
+
+/*!
+ *  @brief  Get the bit at which the last read failed
+ *  @return Bit index 0-39 for DHT_ERROR_BIT_TIMEOUT / DHT_ERROR_BIT_TIMING
+ */
+uint8_t DHT::getErrorBit() const { return _errorBit; }
+
+/*!
+ *  @brief  Get the read statistics
+ *  @return Counters of attempts, successes and each error class
+ */
+const DHTStats &DHT::getStats() const { return _stats; }
+
+/*!
+ *  @brief  Clear the read statistics
+ */
+void DHT::resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+
+/*!
+ *  @brief  Retry failed non-blocking reads automatically. Retries wait
+ *          backoffMs, doubling each time (at least 2 s, at most 16 s), and
+ *          resultReady() only reports after the last attempt.
+ *  @param  maxRetries
+ *          Retries per startRead() (0 = off, the default)
+ *  @param  backoffMs
+ *          Wait before the first retry
+ */
+void DHT::setRetry(uint8_t maxRetries, uint32_t backoffMs) {
+  _maxRetries = maxRetries;
+  _retryBackoff = backoffMs;
+}
+
+/*!
+ *  @brief  Count the result of a bus transaction
+ *  @param  ok
+ *          true if a valid frame was received
+ */
+void DHT::recordResult(bool ok) {
+  _sampleTime = millis();
+  _stats.attempts++;
+  if (ok) {
+    _lastError = DHT_OK;
+    _stats.ok++;
+    return;
+  }
+  switch (_lastError) {
+  case DHT_ERROR_NO_RESPONSE:
+    _stats.noResponse++;
+    break;
+  case DHT_ERROR_PREAMBLE:
+    _stats.preamble++;
+    break;
+  case DHT_ERROR_BIT_TIMEOUT:
+    _stats.bitTimeout++;
+    break;
+  case DHT_ERROR_BIT_TIMING:
+    _stats.bitTiming++;
+    break;
+  case DHT_ERROR_START_OVERRUN:
+    break; // counted in startOverrun per start pulse
+  case DHT_ERROR_RANGE:
+    _stats.range++;
+    break;
+  case DHT_ERROR_CHECKSUM:
+  default:
+    _stats.checksum++;
+    break;
   }
+}
 
+/*!
+ *  @brief  Get the capture backend in use
+ *  @return DHT_CAPTURE_HARDWARE, or DHT_CAPTURE_POLLING if hardware capture
+ *          was not requested or is not available for this board/pin
+ */
+DHTCapture DHT::getCapture() const { return _capture; }
+
+/*!
+ *  @brief  Drive the data line low (start pulse)
+ */
+void DHT::lineLow() {
+#if defined(ESP32)
+  if (_capture == DHT_CAPTURE_HARDWARE) {
+    // Open-drain output keeps the input routed to the RMT receiver
+    gpio_set_level((gpio_num_t)_pin, 0);
+    gpio_set_direction((gpio_num_t)_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    return;
+  }
+#endif
+  pinMode(_pin, OUTPUT);
+  digitalWrite(_pin, LOW);
+}
+
+/*!
+ *  @brief  Release the data line to the pull-up
+ */
+void DHT::lineRelease() {
+#if defined(ESP32)
+  if (_capture == DHT_CAPTURE_HARDWARE) {
+    gpio_set_level((gpio_num_t)_pin, 1);
+    return;
+  }
+#endif
+  pinMode(_pin, INPUT_PULLUP);
+}
+
+/*!
+ *  @brief  Verify the checksum byte of the received frame and that both
+ *          values decode
+ *  @return true if the frame is valid (else sets DHT_ERROR_CHECKSUM or
+ *          DHT_ERROR_RANGE)
+ */
+bool DHT::frameOk() {
   DEBUG_PRINTLN(F("Received from DHT:"));
   DEBUG_PRINT(data[0], HEX);
   DEBUG_PRINT(F(", "));
@@ -342,14 +803,110 @@ bool DHT::read(bool force) {
   DEBUG_PRINTLN((data[0] + data[1] + data[2] + data[3]) & 0xFF, HEX);
 
   // Check we read 40 bits and that the checksum matches.
-  if (data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
-    _lastresult = true;
-    return _lastresult;
-  } else {
+  if (data[4] != ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
     DEBUG_PRINTLN(F("DHT checksum failure!"));
-    _lastresult = false;
-    return _lastresult;
+    _lastError = DHT_ERROR_CHECKSUM;
+    return false;
   }
+  // A DHT21/22 humidity with the top bit set (or an unknown sensor type)
+  // has no deci value; fail the frame instead of returning a sentinel
+  if (dhtTemperatureDeci(data, _type) == DHT_INVALID_DECI ||
+      dhtHumidityDeci(data, _type) == DHT_INVALID_DECI) {
+    DEBUG_PRINTLN(F("DHT value out of range!"));
+    _lastError = DHT_ERROR_RANGE;
+    return false;
+  }
+  return true;
+}
+
+/*!
+ *  @brief  End the start pulse and capture the answer with the hardware
+ *          backend. Interrupts stay enabled while the frame arrives.
+ *  @return true if a valid frame was received
+ */
+bool DHT::readFrameHardware() {
+  captureStart();
+  uint32_t start = micros();
+  while (!captureDone()) {
+    if (micros() - start >= DHT_CAPTURE_TIMEOUT_US) {
+      DEBUG_PRINTLN(F("DHT timeout waiting for hardware capture."));
+      captureStop();
+      return false;
+    }
+  }
+  return captureFinish();
+}
+
+/*!
+ *  @brief  End the start pulse, capture the 40 bit answer and verify its
+ *          checksum. The line must be held low for the start pulse.
+ *  @return true if a valid frame was received
+ */
+bool DHT::readFrame() {
+  {
+    // End the start signal by setting data line high for 40 microseconds.
+    pinMode(_pin, INPUT_PULLUP);
+    // Delay a moment to let sensor pull data line low.
+    delayMicroseconds(pullTime);
+
+    // Now start reading the data line to get the value from the DHT sensor.
+
+    // Turn off interrupts temporarily because the next sections
+    // are timing critical and we don't want any interruptions.
+    InterruptLock lock;
+
+    // First expect a low signal for ~80 microseconds followed by a high signal
+    // for ~80 microseconds again. The low pulse has partly passed during the
+    // pull time, but the high pulse is seen whole: its cycle count is the
+    // reference that the bits are measured against, so thresholds and
+    // timeouts follow the actual loop speed and sensor clock.
+    if (expectPulse(LOW, _maxcycles) == TIMEOUT) {
+      DEBUG_PRINTLN(F("DHT timeout waiting for start signal low pulse."));
+      _lastError = DHT_ERROR_PREAMBLE; // line stuck low
+      return false;
+    }
+    uint32_t ref80 = expectPulse(HIGH, _maxcycles);
+    if (ref80 == TIMEOUT) {
+      DEBUG_PRINTLN(F("DHT timeout waiting for start signal high pulse."));
+      _lastError = DHT_ERROR_NO_RESPONSE;
+      return false;
+    }
+    if (ref80 < 8) {
+      DEBUG_PRINTLN(F("DHT start signal high pulse too short."));
+      _lastError = DHT_ERROR_PREAMBLE;
+      return false;
+    }
+
+    // Now read the 40 bits sent by the sensor.  Each bit is sent as a 50
+    // microsecond low pulse followed by a variable length high pulse.  If the
+    // high pulse is ~28 microseconds then it's a 0 and if it's ~70 microseconds
+    // then it's a 1.  Each bit is decided as soon as its high pulse ends (a
+    // few compares and a shift, short enough to fit before the next pulse),
+    // so no pulse buffer is needed and a broken frame is abandoned at the
+    // first bad pulse. No valid pulse is longer than the 160 us preamble.
+    uint32_t limit = ref80 * 2;
+    for (uint8_t i = 0; i < 40; ++i) {
+      uint32_t lowCycles = expectPulse(LOW, limit);
+      uint32_t highCycles =
+          (lowCycles == TIMEOUT) ? TIMEOUT : expectPulse(HIGH, limit);
+      if (highCycles == TIMEOUT) {
+        DEBUG_PRINTLN(F("DHT timeout waiting for pulse."));
+        _lastError = DHT_ERROR_BIT_TIMEOUT;
+        _errorBit = i;
+        return false;
+      }
+      int8_t bit = dhtDecodeBit(lowCycles, highCycles, ref80);
+      if (bit < 0) {
+        DEBUG_PRINTLN(F("DHT implausible pulse timing."));
+        _lastError = DHT_ERROR_BIT_TIMING;
+        _errorBit = i;
+        return false;
+      }
+      data[i / 8] = (data[i / 8] << 1) | bit;
+    }
+  } // Timing critical code is now complete.
+
+  return frameOk();
 }
 
 // Expect the signal line to be at the specified level for a period of time and
@@ -359,7 +916,7 @@ bool DHT::read(bool force) {
 // This is adapted from Arduino's pulseInLong function (which is only available
 // in the very latest IDE versions):
 //   https://github.com/arduino/Arduino/blob/master/hardware/arduino/avr/cores/arduino/wiring_pulse.c
-uint32_t DHT::expectPulse(bool level) {
+uint32_t DHT::expectPulse(bool level, uint32_t limit) {
 // F_CPU is not be known at compile time on platforms such as STM32F103.
 // The preprocessor seems to evaluate it to zero in that case.
 #if (F_CPU > 16000000L) || (F_CPU == 0L)
@@ -372,7 +929,7 @@ uint32_t DHT::expectPulse(bool level) {
 #ifdef __AVR
   uint8_t portState = level ? _bit : 0;
   while ((*portInputRegister(_port) & _bit) == portState) {
-    if (count++ >= _maxcycles) {
+    if (count++ >= limit) {
       return TIMEOUT; // Exceeded timeout, fail.
     }
   }
@@ -380,7 +937,7 @@ uint32_t DHT::expectPulse(bool level) {
 // ESP8266 right now, perhaps bugs in direct port access functions?).
 #else
   while (digitalRead(_pin) == level) {
-    if (count++ >= _maxcycles) {
+    if (count++ >= limit) {
       return TIMEOUT; // Exceeded timeout, fail.
     }
   }
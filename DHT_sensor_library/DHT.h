@@ -47,6 +47,142 @@ static const uint8_t DHT21{21};  /**< DHT TYPE 21 */
 static const uint8_t DHT22{22};  /**< DHT TYPE 22 */
 static const uint8_t AM2301{21}; /**< AM2301 */
 
+/*! How the sensor's answer is captured */
+enum DHTCapture {
+  DHT_CAPTURE_POLLING, /**< Busy-wait on the pin with interrupts disabled */
+  DHT_CAPTURE_HARDWARE /**< Edge timing in hardware, interrupts stay enabled
+                            (ESP32: RMT, ATmega328P/168: ICP1 on pin 8
+                            with DHT_ICP1.h included; Timer1 can be shared
+                            with ZeroCrossSync).
+                            Falls back to polling where unavailable. */
+};
+
+#define DHT_INVALID_DECI INT16_MIN /**< Deci value of a failed read */
+#define DHT_CAPTURE_TIMEOUT_US 10000 /**< Max time for a hardware capture */
+#define DHT_MAX_BACKOFF 16000 /**< Longest wait between retries (ms) */
+#define DHT_START_RESTARTS 3 /**< Overrun start pulses resent per attempt */
+
+/*! Why the last read failed */
+enum DHTError {
+  DHT_OK,                /**< Valid frame */
+  DHT_ERROR_NO_RESPONSE, /**< Sensor did not answer the start pulse */
+  DHT_ERROR_PREAMBLE,    /**< 80/80 us response preamble missing or malformed */
+  DHT_ERROR_BIT_TIMEOUT, /**< Bit N did not arrive (see getErrorBit()) */
+  DHT_ERROR_BIT_TIMING,  /**< Bit N had implausible pulse lengths */
+  DHT_ERROR_CHECKSUM,    /**< 40 bits received, checksum mismatch */
+  DHT_ERROR_START_OVERRUN, /**< poll() came too late to end the start pulse
+                                within the sensor's maximum (call it more
+                                often) */
+  DHT_ERROR_RANGE /**< Valid checksum, but a value that does not decode
+                       (DHT21/22 humidity above 3276.7 %RH, unknown type) */
+};
+
+/*! Read statistics, for diagnosing wiring and cable problems */
+struct DHTStats {
+  uint32_t attempts;    /**< Bus transactions */
+  uint32_t ok;          /**< Valid frames */
+  uint32_t noResponse;  /**< DHT_ERROR_NO_RESPONSE count */
+  uint32_t preamble;    /**< DHT_ERROR_PREAMBLE count */
+  uint32_t bitTimeout;  /**< DHT_ERROR_BIT_TIMEOUT count */
+  uint32_t bitTiming;   /**< DHT_ERROR_BIT_TIMING count */
+  uint32_t checksum;    /**< DHT_ERROR_CHECKSUM count */
+  uint32_t retries;     /**< Automatic retries (non-blocking reads) */
+  uint32_t startOverrun; /**< Start pulses that overran their maximum */
+  uint32_t range;       /**< DHT_ERROR_RANGE count */
+};
+
+/*! Result of one bus transaction: both values from the same frame */
+struct DHTSample {
+  int16_t temperature; /**< 0.1 °C, DHT_INVALID_DECI if the read failed */
+  int16_t humidity;    /**< 0.1 %RH, DHT_INVALID_DECI if the read failed */
+  DHTError status;     /**< DHT_OK or why the read failed */
+  uint32_t timestamp;  /**< millis() when the frame was received */
+};
+
+/*!
+ *  @brief  Decode one bit from its low and high pulse, measured in the same
+ *          unit as the preamble high pulse (~80 us) of the frame. Shared by
+ *          the polling reader and the hardware capture backends.
+ *  @param  low
+ *          Length of the ~50 us low pulse
+ *  @param  high
+ *          Length of the high pulse (~26 us = 0, ~70 us = 1)
+ *  @param  ref80
+ *          Length of the preamble high pulse
+ *  @return 0 or 1, or -1 if the pulse lengths are implausible
+ */
+static inline int8_t dhtDecodeBit(uint32_t low, uint32_t high, uint32_t ref80) {
+  // Plausible: low 20..120 us, high at most 110 us; 1 if high > 48 us
+  if (low * 4 < ref80 || low * 2 > ref80 * 3 || high * 8 > ref80 * 11) {
+    return -1;
+  }
+  return (high * 5 > ref80 * 3) ? 1 : 0;
+}
+
+/*!
+ *  @brief  Temperature of a frame in tenths of a degree Celsius, integer
+ *          only (no soft-float on AVR)
+ *  @param  data
+ *          The 5 frame bytes
+ *  @param  type
+ *          Sensor type
+ *  @return Temperature in 0.1 °C, or DHT_INVALID_DECI for an unknown type
+ */
+static inline int16_t dhtTemperatureDeci(const uint8_t data[5], uint8_t type) {
+  int16_t t;
+  switch (type) {
+  case DHT11:
+    t = data[2];
+    if (data[3] & 0x80) {
+      t = -1 - t;
+    }
+    return t * 10 + (data[3] & 0x0f);
+  case DHT12:
+    t = data[2] * 10 + (data[3] & 0x0f);
+    return (data[2] & 0x80) ? -t : t;
+  case DHT22:
+  case DHT21:
+    t = ((uint16_t)(data[2] & 0x7F)) << 8 | data[3];
+    return (data[2] & 0x80) ? -t : t;
+  default:
+    return DHT_INVALID_DECI;
+  }
+}
+
+/*!
+ *  @brief  Humidity of a frame in tenths of a percent, integer only
+ *  @param  data
+ *          The 5 frame bytes
+ *  @param  type
+ *          Sensor type
+ *  @return Humidity in 0.1 %RH, or DHT_INVALID_DECI for an unknown type or
+ *          a DHT21/22 value that does not fit (above 3276.7 %RH)
+ */
+static inline int16_t dhtHumidityDeci(const uint8_t data[5], uint8_t type) {
+  switch (type) {
+  case DHT11:
+  case DHT12:
+    return data[0] * 10 + data[1];
+  case DHT22:
+  case DHT21:
+    if (data[0] & 0x80) {
+      return DHT_INVALID_DECI;
+    }
+    return (int16_t)(((uint16_t)data[0]) << 8 | data[1]);
+  default:
+    return DHT_INVALID_DECI;
+  }
+}
+
+// ICP1 capture backend, enabled and called by DHT_ICP1.h (DHT_capture.cpp)
+bool dhtIcp1Enable();
+void dhtIcp1Capture();
+
+#if defined(ESP32)
+#include "esp32-hal-rmt.h"
+#define DHT_RMT_SYMBOLS 48 /**< Fits one RMT memory block on all ESP32s */
+#endif
+
 #if defined(TARGET_NAME) && (TARGET_NAME == ARDUINO_NANO33BLE)
 #ifndef microsecondsToClockCycles
 /*!
@@ -62,18 +198,53 @@ static const uint8_t AM2301{21}; /**< AM2301 */
  */
 class DHT {
 public:
-  DHT(uint8_t pin, uint8_t type, uint8_t count = 6);
+  DHT(uint8_t pin, uint8_t type, uint8_t count = 6,
+      DHTCapture capture = DHT_CAPTURE_POLLING);
   void begin(uint8_t usec = 55);
   float readTemperature(bool S = false, bool force = false);
+  int16_t readTemperatureDeci(bool force = false);
   float convertCtoF(float);
   float convertFtoC(float);
+  static int16_t convertDeciCtoF(int16_t c);
   float computeHeatIndex(bool isFahrenheit = true);
-  float computeHeatIndex(float temperature, float percentHumidity,
-                         bool isFahrenheit = true);
+  static float computeHeatIndex(float temperature, float percentHumidity,
+                                bool isFahrenheit = true);
+  static int16_t computeHeatIndexDeci(int16_t temperature,
+                                      int16_t percentHumidity);
+  static float computeDewPoint(float temperature, float percentHumidity,
+                               bool isFahrenheit = true);
+  static void computeHeatIndexBatch(const float *temperature,
+                                    const float *percentHumidity, float *out,
+                                    size_t count, bool isFahrenheit = true);
+  static void computeDewPointBatch(const float *temperature,
+                                   const float *percentHumidity, float *out,
+                                   size_t count, bool isFahrenheit = true);
   float readHumidity(bool force = false);
+  int16_t readHumidityDeci(bool force = false);
   bool read(bool force = false);
+  bool readSample(DHTSample &sample, bool force = false);
+  bool startRead(bool force = false);
+  bool poll();
+  bool resultReady();
+  bool isReading() const;
+  DHTCapture getCapture() const;
+  DHTError getLastError() const;
+  uint8_t getErrorBit() const;
+  const DHTStats &getStats() const;
+  void resetStats();
+  void setRetry(uint8_t maxRetries, uint32_t backoffMs = 2000);
 
 private:
+  /*! Steps of a non-blocking read started with startRead() */
+  enum AsyncState {
+    ASYNC_IDLE,   /**< No read in progress */
+    ASYNC_PULLUP, /**< Line released, waiting before the start pulse */
+    ASYNC_START,  /**< Line held low for the start pulse */
+    ASYNC_CAPTURE, /**< Hardware capture of the answer running */
+    ASYNC_BACKOFF, /**< Failed, waiting to retry */
+    ASYNC_DONE    /**< Frame captured, result not yet collected */
+  };
+
   uint8_t data[5];
   uint8_t _pin, _type;
 #ifdef __AVR
@@ -83,10 +254,43 @@ private:
   uint8_t _bit, _port;
 #endif
   uint32_t _lastreadtime, _maxcycles;
+  uint32_t _sampleTime; // millis() at the end of the last bus transaction
   bool _lastresult;
   uint8_t pullTime; // Time (in usec) to pull up data line before reading
+  AsyncState _asyncState;
+  uint32_t _asyncSince;  // micros() when the current async step started
+  uint32_t _asyncWait;   // length of the current async step in usec
+  DHTCapture _capture;   // requested at construction, effective after begin()
+  DHTError _lastError;
+  uint8_t _errorBit;     // bit index for DHT_ERROR_BIT_*
+  DHTStats _stats;
+  uint8_t _maxRetries;   // automatic retries of a failed non-blocking read
+  uint8_t _retry;        // retries used by the current non-blocking read
+  uint8_t _startRestarts; // overrun start pulses resent in this attempt
+  uint32_t _retryBackoff; // ms before the first retry (doubles each time)
+#if defined(ESP32)
+  rmt_data_t _symbols[DHT_RMT_SYMBOLS];
+  size_t _symbolCount;
+#endif
+
+  uint32_t startPulseMicros() const;
+  uint32_t startPulseMaxMicros() const;
+  void lineLow();
+  void lineRelease();
+  bool frameOk();
+  bool readFrame();
+  bool readFrameHardware();
+  void recordResult(bool ok);
+  bool finishAsync();
+  void startPullup();
 
-  uint32_t expectPulse(bool level);
+  // Hardware capture backends (DHT_capture.cpp)
+  bool captureInit();
+  void captureStart();
+  bool captureDone();
+  bool captureFinish();
+  void captureStop();
+  uint32_t expectPulse(bool level, uint32_t limit);
 };
 
 /*!
@@ -0,0 +1,129 @@
+/*!
+ *  @file DHT_Array.cpp
+ *
+ *  Scheduler that reads many DHT sensors without blocking.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include "DHT_Array.h"
+
+/*!
+ *  @brief  Instantiates a new DHTArray
+ *  @param  periodMs
+ *          Time between two reads of the same sensor (at least 2000 ms)
+ */
+DHTArray::DHTArray(uint32_t periodMs) {
+  _count = 0;
+  _period = (periodMs < DHT_ARRAY_MIN_PERIOD) ? DHT_ARRAY_MIN_PERIOD : periodMs;
+}
+
+/*!
+ *  @brief  Add a sensor (call its begin() before begin() of the array)
+ *  @param  sensor
+ *          Sensor to schedule
+ *  @return false if the array is full
+ */
+bool DHTArray::add(DHT &sensor) {
+  if (_count >= DHT_ARRAY_MAX) {
+    return false;
+  }
+  Slot &s = _slots[_count++];
+  s.sensor = &sensor;
+  s.nextDue = 0;
+  s.readAt = 0;
+  s.temperature = NAN;
+  s.humidity = NAN;
+  s.everRead = false;
+  s.lastOk = false;
+  return true;
+}
+
+/*!
+ *  @brief  Start the schedule; sensor i is first read at i * period / n
+ */
+void DHTArray::begin() {
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < _count; i++) {
+    _slots[i].nextDue = now + (uint32_t)i * _period / _count;
+  }
+}
+
+/*!
+ *  @brief  Start due reads, advance running ones and collect results.
+ *          Call it as often as possible (every loop()); it never waits.
+ */
+void DHTArray::update() {
+  uint32_t now = millis();
+
+  for (uint8_t i = 0; i < _count; i++) {
+    Slot &s = _slots[i];
+
+    if (!s.sensor->isReading() && (int32_t)(now - s.nextDue) >= 0) {
+      // startRead() refuses while the sensor's own 2 s interval runs,
+      // then this is simply tried again on the next update()
+      if (s.sensor->startRead()) {
+        s.nextDue += _period;
+        if ((int32_t)(now - s.nextDue) >= 0) {
+          s.nextDue = now + _period; // fell behind, keep the spacing
+        }
+      }
+    }
+
+    s.sensor->poll();
+
+    if (s.sensor->resultReady()) {
+      // Served from the frame just captured, no second bus transaction
+      DHTSample sample;
+      s.lastOk = s.sensor->readSample(sample);
+      if (s.lastOk) {
+        s.temperature = sample.temperature * 0.1;
+        s.humidity = sample.humidity * 0.1;
+        s.readAt = sample.timestamp;
+        s.everRead = true;
+      }
+    }
+  }
+}
+
+/*!
+ *  @brief  Number of sensors in the array
+ *  @return Sensor count
+ */
+uint8_t DHTArray::size() const { return _count; }
+
+/*!
+ *  @brief  Latest reading of one sensor
+ *  @param  index
+ *          Sensor index (order of add())
+ *  @param  reading
+ *          Receives the values and their age
+ *  @return false if the index is out of range
+ */
+bool DHTArray::get(uint8_t index, DHTArrayReading &reading) const {
+  if (index >= _count) {
+    return false;
+  }
+  const Slot &s = _slots[index];
+  reading.temperature = s.temperature;
+  reading.humidity = s.humidity;
+  reading.ageMs = s.everRead ? millis() - s.readAt : DHT_ARRAY_NEVER;
+  reading.lastOk = s.lastOk;
+  return true;
+}
+
+/*!
+ *  @brief  Latest readings of all sensors
+ *  @param  readings
+ *          Array that receives one entry per sensor
+ *  @param  max
+ *          Capacity of the array
+ *  @return Number of entries written
+ */
+uint8_t DHTArray::snapshot(DHTArrayReading *readings, uint8_t max) const {
+  uint8_t n = (_count < max) ? _count : max;
+  for (uint8_t i = 0; i < n; i++) {
+    get(i, readings[i]);
+  }
+  return n;
+}
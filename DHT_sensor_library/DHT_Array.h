@@ -0,0 +1,65 @@
+/*!
+ *  @file DHT_Array.h
+ *
+ *  Scheduler that reads many DHT sensors without blocking.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef DHT_ARRAY_H
+#define DHT_ARRAY_H
+
+#include "DHT.h"
+
+#define DHT_ARRAY_MAX 16          /**< Sensors per array */
+#define DHT_ARRAY_MIN_PERIOD 2000 /**< Sensor minimum read interval (ms) */
+#define DHT_ARRAY_NEVER 0xFFFFFFFF /**< Age of a sensor never read */
+
+/*!
+ *  @brief  Latest reading of one sensor in a DHTArray
+ */
+struct DHTArrayReading {
+  float temperature; /**< Last good temperature in °C (NAN if none yet) */
+  float humidity;    /**< Last good humidity in %RH (NAN if none yet) */
+  uint32_t ageMs;    /**< Time since the last good reading, DHT_ARRAY_NEVER
+                          if there was none */
+  bool lastOk;       /**< Whether the most recent attempt succeeded */
+};
+
+/*!
+ *  @brief  Reads a group of DHT sensors with the non-blocking
+ *          startRead()/poll() interface.
+ *
+ *  Reads are spread evenly over the period (sensor i starts at
+ *  i * period / n), so the CPU load is flat and the start pulses of the
+ *  sensors overlap with other work instead of being waited out one after
+ *  the other. No sensor is read more often than every 2 s.
+ */
+class DHTArray {
+public:
+  DHTArray(uint32_t periodMs = DHT_ARRAY_MIN_PERIOD);
+  bool add(DHT &sensor);
+  void begin();
+  void update();
+  uint8_t size() const;
+  bool get(uint8_t index, DHTArrayReading &reading) const;
+  uint8_t snapshot(DHTArrayReading *readings, uint8_t max) const;
+
+private:
+  /*! State of one sensor */
+  struct Slot {
+    DHT *sensor;       /**< Sensor */
+    uint32_t nextDue;  /**< millis() when the next read starts */
+    uint32_t readAt;   /**< millis() of the last good reading */
+    float temperature; /**< Last good temperature */
+    float humidity;    /**< Last good humidity */
+    bool everRead;     /**< A good reading exists */
+    bool lastOk;       /**< Result of the last attempt */
+  };
+
+  Slot _slots[DHT_ARRAY_MAX];
+  uint8_t _count;
+  uint32_t _period;
+};
+
+#endif
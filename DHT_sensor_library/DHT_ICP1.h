@@ -0,0 +1,35 @@
+/*!
+ *  @file DHT_ICP1.h
+ *
+ *  Opt-in Timer1 input capture backend for DHT_CAPTURE_HARDWARE on
+ *  ATmega328P/168 (ICP1 = digital pin 8). Include this header in the sketch,
+ *  in one file only:
+ *
+ *    #include <DHT.h>
+ *    #include <DHT_ICP1.h>
+ *    DHT dht(8, DHT22, 6, DHT_CAPTURE_HARDWARE);
+ *
+ *  The capture vector lives here and not in the library, because Arduino
+ *  links every library object into the sketch: sketches that do not include
+ *  this header keep TIMER1_CAPT_vect free for AltSoftSerial, FreqMeasure,
+ *  InputCapture and others, and their DHT_CAPTURE_HARDWARE sensors fall back
+ *  to polling. With it, those libraries cannot be used alongside.
+ *
+ *  On other boards this header does nothing (ESP32 uses the RMT).
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef DHT_ICP1_H
+#define DHT_ICP1_H
+
+#include "DHT.h"
+
+#if defined(TIMER1_CAPT_vect) &&                                               \
+    (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__))
+ISR(TIMER1_CAPT_vect) { dhtIcp1Capture(); }
+
+static const bool dhtICP1Capture = dhtIcp1Enable();
+#endif
+
+#endif // DHT_ICP1_H
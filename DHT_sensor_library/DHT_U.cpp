@@ -114,8 +114,13 @@ bool DHT_Unified::Temperature::getEvent(sensors_event_t *event) {
   event->version = sizeof(sensors_event_t);
   event->sensor_id = _id;
   event->type = SENSOR_TYPE_AMBIENT_TEMPERATURE;
-  event->timestamp = millis();
-  event->temperature = _parent->_dht.readTemperature();
+  // Served from the same sample as the humidity event
+  DHTSample sample;
+  _parent->_dht.readSample(sample);
+  event->timestamp = sample.timestamp;
+  event->temperature = (sample.temperature == DHT_INVALID_DECI)
+                           ? NAN
+                           : sample.temperature * 0.1;
 
   return true;
 }
@@ -187,8 +192,12 @@ bool DHT_Unified::Humidity::getEvent(sensors_event_t *event) {
   event->version = sizeof(sensors_event_t);
   event->sensor_id = _id;
   event->type = SENSOR_TYPE_RELATIVE_HUMIDITY;
-  event->timestamp = millis();
-  event->relative_humidity = _parent->_dht.readHumidity();
+  // Served from the same sample as the temperature event
+  DHTSample sample;
+  _parent->_dht.readSample(sample);
+  event->timestamp = sample.timestamp;
+  event->relative_humidity =
+      (sample.humidity == DHT_INVALID_DECI) ? NAN : sample.humidity * 0.1;
 
   return true;
 }
@@ -0,0 +1,281 @@
+/*!
+ *  @file DHT_capture.cpp
+ *
+ *  Hardware edge-capture backends for the DHT class
+ *  (DHT_CAPTURE_HARDWARE). The edge times are recorded by a peripheral,
+ *  so interrupts stay enabled while the frame arrives. Each backend only
+ *  fills the 5 data bytes; checksum and conversion are shared with the
+ *  polling reader.
+ *
+ *  - ESP32: RMT receiver at 1 MHz. The start pulse is driven with the pin
+ *    in open-drain mode so it stays routed to the RMT input.
+ *  - ATmega328P/168: Timer1 input capture (ICP1 = digital pin 8), opt-in:
+ *    the sketch includes DHT_ICP1.h, which defines the capture vector.
+ *    Without it, captureInit() fails and begin() falls back to polling, so
+ *    TIMER1_CAPT_vect stays free for AltSoftSerial, FreqMeasure and others
+ *    (Arduino links every library object into the sketch, so a vector
+ *    defined here would clash even when unused). Timer1 runs in normal
+ *    mode at clk/64, so analogWrite() on pins 9/10 and the
+ *    Servo library cannot be used together with this backend. It can share
+ *    Timer1 with RelayController's ZeroCrossSync (compare B, same mode and
+ *    clock); a relay switch that fires during a frame delays the capture
+ *    interrupt and may cost that read (DHT_ERROR_BIT_TIMING).
+ *  - Other boards: not available, begin() falls back to polling.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include "DHT.h"
+
+#if defined(ESP32)
+#include "driver/gpio.h"
+
+/* Shortest pulse the RMT filter passes and the gap that ends a frame */
+#define DHT_RMT_FILTER_TICKS 3
+#define DHT_RMT_IDLE_TICKS 200
+
+/*!
+ *  @brief  Set up the RMT receiver on the data pin
+ *  @return true on success
+ */
+bool DHT::captureInit() {
+  if (!rmtInit(_pin, RMT_RX_MODE, RMT_MEM_NUM_BLOCKS_1, 1000000)) {
+    return false;
+  }
+  rmtSetRxMinThreshold(_pin, DHT_RMT_FILTER_TICKS);
+  rmtSetRxMaxThreshold(_pin, DHT_RMT_IDLE_TICKS);
+  gpio_pullup_en((gpio_num_t)_pin);
+  gpio_set_level((gpio_num_t)_pin, 1);
+  gpio_set_direction((gpio_num_t)_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+  return true;
+}
+
+/*!
+ *  @brief  Arm the receiver and end the start pulse
+ */
+void DHT::captureStart() {
+  _symbolCount = DHT_RMT_SYMBOLS;
+  rmtReadAsync(_pin, _symbols, &_symbolCount);
+  lineRelease();
+}
+
+/*!
+ *  @brief  Check whether the frame has been received
+ *  @return true once the line went idle after the frame
+ */
+bool DHT::captureDone() { return rmtReceiveCompleted(_pin); }
+
+/*!
+ *  @brief  Decode the received symbols into the data bytes
+ *  @return true if 40 bits were received and the checksum matches
+ */
+bool DHT::captureFinish() {
+  // Each symbol is one low/high pair. The first ones are the end of the
+  // start pulse and the response delay; the sensor's 80/80 us preamble is
+  // the first pair with a long low and high phase.
+  size_t first = 0;
+  while (first < _symbolCount &&
+         !(_symbols[first].level0 == 0 && _symbols[first].duration0 >= 60 &&
+           _symbols[first].duration1 >= 60)) {
+    first++;
+  }
+  if (first >= _symbolCount) {
+    DEBUG_PRINTLN(F("DHT no preamble from RMT."));
+    _lastError = (_symbolCount <= 1) ? DHT_ERROR_NO_RESPONSE
+                                     : DHT_ERROR_PREAMBLE;
+    return false;
+  }
+  // The preamble high phase is the timing reference for the bits
+  uint32_t ref80 = _symbols[first].duration1;
+  first++; // first data bit
+
+  for (uint8_t i = 0; i < 40; i++) {
+    if (first + i >= _symbolCount) {
+      DEBUG_PRINTLN(F("DHT incomplete frame from RMT."));
+      _lastError = DHT_ERROR_BIT_TIMEOUT;
+      _errorBit = i;
+      return false;
+    }
+    const rmt_data_t &s = _symbols[first + i];
+    int8_t bit = dhtDecodeBit(s.duration0, s.duration1, ref80);
+    if (bit < 0) {
+      DEBUG_PRINTLN(F("DHT implausible pulse timing."));
+      _lastError = DHT_ERROR_BIT_TIMING;
+      _errorBit = i;
+      return false;
+    }
+    data[i / 8] = (data[i / 8] << 1) | bit;
+  }
+  return frameOk();
+}
+
+/*!
+ *  @brief  Abort a capture (re-initialises the receiver)
+ */
+void DHT::captureStop() {
+  _lastError = DHT_ERROR_NO_RESPONSE; // the line never went idle again
+  rmtDeinit(_pin);
+  captureInit();
+}
+
+#elif defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+
+#define DHT_ICP1_PIN 8 /**< ICP1 is PB0 = digital pin 8 */
+
+static volatile uint8_t icpData[5]; // bits decoded in the ISR
+static volatile uint8_t icpPairs;   // low/high pairs seen (preamble + 40)
+static volatile uint8_t icpLow;     // last low phase in timer ticks
+static volatile uint8_t icpRef;     // preamble high phase in timer ticks
+static volatile uint16_t icpLastEdge;
+static volatile bool icpStarted;
+static volatile bool icpFail; // implausible bit timing, capture stopped
+static bool icpEnabled;       // set by DHT_ICP1.h
+
+/*!
+ *  @brief  Enable the ICP1 backend (called by DHT_ICP1.h)
+ *  @return true
+ */
+bool dhtIcp1Enable() {
+  icpEnabled = true;
+  return true;
+}
+
+/*
+ * Capture interrupt, called from TIMER1_CAPT_vect in DHT_ICP1.h.
+ * Edge order after the start pulse: falling (response), rising, falling
+ * (preamble), then per bit rising (end of ~50 us low) and falling (end of
+ * the 26/70 us high). A bit is decided as soon as its high phase ends.
+ */
+void dhtIcp1Capture() {
+  uint16_t t = ICR1;
+  uint16_t d = t - icpLastEdge;
+  icpLastEdge = t;
+
+  if (TCCR1B & _BV(ICES1)) {
+    // Rising edge: a low phase ended
+    icpLow = (d > 255) ? 255 : d;
+    TCCR1B &= ~_BV(ICES1);
+  } else {
+    // Falling edge: a high phase ended
+    if (d > 255) {
+      d = 255;
+    }
+    if (icpStarted) {
+      if (icpPairs == 0) {
+        icpRef = d; // preamble high, the reference for the bits
+      } else {
+        uint8_t i = icpPairs - 1;
+        int8_t bit = dhtDecodeBit(icpLow, d, icpRef);
+        if (bit < 0) {
+          icpFail = true;
+          TIMSK1 &= ~_BV(ICIE1);
+          return;
+        }
+        icpData[i / 8] = (icpData[i / 8] << 1) | bit;
+      }
+      if (++icpPairs >= 41) {
+        TIMSK1 &= ~_BV(ICIE1); // frame complete
+      }
+    }
+    icpStarted = true;
+    TCCR1B |= _BV(ICES1);
+  }
+  TIFR1 = _BV(ICF1); // edge select changed, drop a stale flag
+}
+
+/*!
+ *  @brief  Set up Timer1 for input capture on ICP1
+ *  @return false if the sketch did not include DHT_ICP1.h or the sensor is
+ *          not on the ICP1 pin
+ */
+bool DHT::captureInit() {
+  if (!icpEnabled || _pin != DHT_ICP1_PIN) {
+    return false;
+  }
+  uint8_t oldSREG = SREG;
+  cli();
+  // Normal mode, clk/64, noise canceler. Compare A/B bits are left alone, so
+  // RelayController's ZeroCrossSync (same mode and clock, compare B) can
+  // share the timer; TCNT1 is never reset.
+  TCCR1A &= ~(_BV(WGM11) | _BV(WGM10));
+  TCCR1B = (TCCR1B & ~(_BV(WGM13) | _BV(WGM12) | _BV(CS12) | _BV(CS11) | _BV(CS10))) |
+           _BV(ICNC1) | _BV(CS11) | _BV(CS10);
+  TIMSK1 &= ~_BV(ICIE1);
+  SREG = oldSREG;
+  return true;
+}
+
+/*!
+ *  @brief  Arm the capture and end the start pulse
+ */
+void DHT::captureStart() {
+  uint8_t oldSREG = SREG;
+  cli();
+  for (uint8_t i = 0; i < 5; i++) {
+    icpData[i] = 0;
+  }
+  icpPairs = 0;
+  icpStarted = false;
+  icpFail = false;
+  icpLastEdge = TCNT1;
+  TCCR1B &= ~_BV(ICES1); // sensor answers with a falling edge
+  TIFR1 = _BV(ICF1);
+  TIMSK1 |= _BV(ICIE1);
+  SREG = oldSREG;
+  lineRelease();
+}
+
+/*!
+ *  @brief  Check whether the frame has been received
+ *  @return true after the 40th bit or a rejected bit
+ */
+bool DHT::captureDone() { return icpPairs >= 41 || icpFail; }
+
+/*!
+ *  @brief  Copy the decoded bits into the data bytes
+ *  @return true if the checksum matches
+ */
+bool DHT::captureFinish() {
+  if (icpFail) {
+    DEBUG_PRINTLN(F("DHT implausible pulse timing."));
+    _lastError = DHT_ERROR_BIT_TIMING;
+    _errorBit = icpPairs - 1;
+    return false;
+  }
+  for (uint8_t i = 0; i < 5; i++) {
+    data[i] = icpData[i];
+  }
+  return frameOk();
+}
+
+/*!
+ *  @brief  Abort a capture and classify how far the frame got
+ */
+void DHT::captureStop() {
+  TIMSK1 &= ~_BV(ICIE1);
+  if (!icpStarted) {
+    _lastError = DHT_ERROR_NO_RESPONSE;
+  } else if (icpPairs == 0) {
+    _lastError = DHT_ERROR_PREAMBLE;
+  } else {
+    _lastError = DHT_ERROR_BIT_TIMEOUT;
+    _errorBit = icpPairs - 1;
+  }
+}
+
+#else
+
+bool dhtIcp1Enable() { return false; }
+void dhtIcp1Capture() {}
+
+/*!
+ *  @brief  No hardware capture on this board
+ *  @return false, begin() falls back to polling
+ */
+bool DHT::captureInit() { return false; }
+void DHT::captureStart() {}
+bool DHT::captureDone() { return true; }
+bool DHT::captureFinish() { return false; }
+void DHT::captureStop() { _lastError = DHT_ERROR_NO_RESPONSE; }
+
+#endif
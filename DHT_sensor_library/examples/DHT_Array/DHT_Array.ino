@@ -0,0 +1,62 @@
+// Reads several DHT sensors without blocking loop().
+// DHTArray spreads the reads evenly over the period, so the start pulses
+// run in the background and the loop keeps spinning.
+
+// REQUIRES the following Arduino libraries:
+// - DHT Sensor Library: https://github.com/adafruit/DHT-sensor-library
+// - Adafruit Unified Sensor Lib: https://github.com/adafruit/Adafruit_Sensor
+
+#include "DHT_Array.h"
+
+DHT sensor1(2, DHT22);
+DHT sensor2(3, DHT22);
+DHT sensor3(4, DHT11);
+DHT sensor4(5, DHT11);
+
+DHTArray sensors(2000); // each sensor every 2 seconds
+
+void setup() {
+  Serial.begin(9600);
+  sensor1.begin();
+  sensor2.begin();
+  sensor3.begin();
+  sensor4.begin();
+
+  sensors.add(sensor1);
+  sensors.add(sensor2);
+  sensors.add(sensor3);
+  sensors.add(sensor4);
+  sensors.begin();
+}
+
+void loop() {
+  static uint32_t lastPrint = 0;
+
+  sensors.update();
+
+  if (millis() - lastPrint >= 5000) {
+    lastPrint = millis();
+
+    DHTArrayReading readings[4];
+    uint8_t n = sensors.snapshot(readings, 4);
+    for (uint8_t i = 0; i < n; i++) {
+      Serial.print(F("Sensor "));
+      Serial.print(i + 1);
+      Serial.print(F(": "));
+      if (readings[i].ageMs == DHT_ARRAY_NEVER) {
+        Serial.println(F("no reading yet"));
+        continue;
+      }
+      Serial.print(readings[i].temperature, 1);
+      Serial.print(F("°C "));
+      Serial.print(readings[i].humidity, 1);
+      Serial.print(F("% ("));
+      Serial.print(readings[i].ageMs / 1000.0, 1);
+      Serial.print(F(" s old"));
+      if (!readings[i].lastOk) {
+        Serial.print(F(", last read failed"));
+      }
+      Serial.println(F(")"));
+    }
+  }
+}
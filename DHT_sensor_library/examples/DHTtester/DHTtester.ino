@@ -59,6 +59,8 @@ void loop() {
   float hif = dht.computeHeatIndex(f, h);
   // Compute heat index in Celsius (isFahreheit = false)
   float hic = dht.computeHeatIndex(t, h, false);
+  // Compute dew point in Celsius
+  float dpc = dht.computeDewPoint(t, h, false);
 
   Serial.print(F("Humidity: "));
   Serial.print(h);
@@ -70,5 +72,7 @@ void loop() {
   Serial.print(hic);
   Serial.print(F("°C "));
   Serial.print(hif);
-  Serial.println(F("°F"));
+  Serial.print(F("°F  Dew point: "));
+  Serial.print(dpc);
+  Serial.println(F("°C"));
 }
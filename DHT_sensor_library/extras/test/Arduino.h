@@ -0,0 +1,42 @@
+// Minimal Arduino API for building the library on a host (tests only).
+// Time only moves when the test (or a hook) advances hostMicros; the pin
+// hooks let a test simulate a sensor on the data line.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define DEC 10
+#define HEX 16
+#define F(s) (s)
+#define F_CPU 16000000L
+#define microsecondsToClockCycles(a) ((a) * (F_CPU / 1000000L))
+
+extern uint32_t hostMicros;
+extern void (*hostPinModeHook)(uint8_t pin, uint8_t mode);
+extern int (*hostReadHook)(uint8_t pin);
+
+inline unsigned long micros() { return hostMicros; }
+inline unsigned long millis() { return hostMicros / 1000; }
+inline void delay(unsigned long ms) { hostMicros += ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { hostMicros += us; }
+inline void yield() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void pinMode(uint8_t pin, uint8_t mode) {
+  if (hostPinModeHook) {
+    hostPinModeHook(pin, mode);
+  }
+}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) { return hostReadHook ? hostReadHook(pin) : HIGH; }
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Host test: a read() or readSample() made while a non-blocking read is in
+ * progress must return the previous result, never a cleared or half
+ * received frame, and must not touch the bus (not even with force).
+ * A poll() that comes after the sensor's maximum start pulse must resend
+ * the start pulse instead of reading a sensor that will not answer.
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../.. DHT_async_test.cpp ../../DHT.cpp
+ *     ../../DHT_capture.cpp -o dht_async_test && ./dht_async_test
+ */
+
+#include <stdio.h>
+#include "DHT.h"
+
+uint32_t hostMicros = 0;
+void (*hostPinModeHook)(uint8_t pin, uint8_t mode) = NULL;
+int (*hostReadHook)(uint8_t pin) = NULL;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL line %d: %s\n", __LINE__, #cond);                           \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// Simulated DHT22: answers when the host releases the line after holding
+// it low for 0.8 to 20 ms. Every digitalRead() takes 1 us, so loop cycles
+// equal microseconds.
+static uint8_t frame[5];
+static bool answer = true;
+static bool answering = false;
+static bool lineLowNow = false;
+static uint32_t lowAt = 0;
+static uint32_t releasedAt = 0;
+static int modeChanges = 0;
+
+static void pinModeHook(uint8_t, uint8_t mode) {
+  modeChanges++;
+  if (mode == OUTPUT) {
+    lineLowNow = true;
+    lowAt = hostMicros;
+  } else if (lineLowNow) {
+    lineLowNow = false;
+    releasedAt = hostMicros;
+    answering = answer && hostMicros - lowAt >= 800 && hostMicros - lowAt <= 20000;
+  }
+}
+
+static int readHook(uint8_t) {
+  uint32_t t = hostMicros++ - releasedAt;
+  if (!answering || t < 30) {
+    return HIGH;
+  }
+  t -= 30;
+  if (t < 80) {
+    return LOW;
+  }
+  t -= 80;
+  if (t < 80) {
+    return HIGH;
+  }
+  t -= 80;
+  for (uint8_t i = 0; i < 40; i++) {
+    uint32_t high = (frame[i / 8] & (0x80 >> (i % 8))) ? 70 : 26;
+    if (t < 50) {
+      return LOW;
+    }
+    t -= 50;
+    if (t < high) {
+      return HIGH;
+    }
+    t -= high;
+  }
+  return t < 50 ? LOW : HIGH;
+}
+
+static void setFrame(int16_t temperature, int16_t humidity) {
+  uint16_t t = temperature < 0 ? (0x8000 | -temperature) : temperature;
+  frame[0] = humidity >> 8;
+  frame[1] = humidity & 0xFF;
+  frame[2] = t >> 8;
+  frame[3] = t & 0xFF;
+  frame[4] = frame[0] + frame[1] + frame[2] + frame[3];
+}
+
+// Every cached access during an async read must see the previous sample
+static void checkCached(DHT &dht, bool ok, int16_t t, int16_t h, uint32_t ts) {
+  int before = modeChanges;
+  DHTSample s;
+  CHECK(dht.readSample(s) == ok);
+  CHECK(dht.readSample(s, true) == ok);
+  CHECK(s.temperature == (ok ? t : DHT_INVALID_DECI));
+  CHECK(s.humidity == (ok ? h : DHT_INVALID_DECI));
+  CHECK(s.timestamp == ts);
+  CHECK(dht.readTemperatureDeci() == (ok ? t : DHT_INVALID_DECI));
+  CHECK(dht.readHumidityDeci(true) == (ok ? h : DHT_INVALID_DECI));
+  CHECK(modeChanges == before); // bus untouched
+}
+
+// Run a non-blocking read to the end, checking the cached path between steps
+static void runAsync(DHT &dht, bool ok, int16_t t, int16_t h, uint32_t ts) {
+  CHECK(dht.startRead());
+  int steps = 0;
+  do {
+    checkCached(dht, ok, t, h, ts);
+    hostMicros += 300;
+    steps++;
+  } while (dht.poll() && steps < 1000);
+  CHECK(dht.resultReady());
+}
+
+// Non-blocking read where polls number slowFrom .. slowFrom + slowCount - 1
+// come 25 ms apart (a slow loop()), the others every 300 us
+static void runSlowPolls(DHT &dht, int slowFrom, int slowCount) {
+  CHECK(dht.startRead());
+  int steps = 0;
+  do {
+    bool slow = steps >= slowFrom && steps < slowFrom + slowCount;
+    hostMicros += slow ? 25000 : 300;
+    steps++;
+  } while (dht.poll() && steps < 1000);
+  CHECK(dht.resultReady());
+}
+
+int main() {
+  hostPinModeHook = pinModeHook;
+  hostReadHook = readHook;
+  hostMicros = 5000000;
+
+  DHT dht(2, DHT22);
+  dht.begin();
+
+  // Blocking read of a first frame
+  setFrame(235, 500);
+  DHTSample s;
+  CHECK(dht.readSample(s));
+  CHECK(s.temperature == 235 && s.humidity == 500);
+  uint32_t firstTime = s.timestamp;
+
+  // Async read of a second frame: the first stays visible until it is done
+  hostMicros += 2500000;
+  setFrame(-41, 480);
+  runAsync(dht, true, 235, 500, firstTime);
+  CHECK(dht.readSample(s));
+  CHECK(s.temperature == -41 && s.humidity == 480);
+  uint32_t secondTime = s.timestamp;
+  CHECK(secondTime != firstTime);
+
+  // Async read that fails: the second frame stays visible, then the error
+  hostMicros += 2500000;
+  answer = false;
+  runAsync(dht, true, -41, 480, secondTime);
+  CHECK(!dht.readSample(s));
+  CHECK(s.status == DHT_ERROR_NO_RESPONSE);
+
+  // After a failure, a failed result is reported during the next async read
+  hostMicros += 2500000;
+  answer = true;
+  setFrame(250, 455);
+  runAsync(dht, false, 0, 0, s.timestamp);
+  CHECK(dht.readSample(s));
+  CHECK(s.temperature == 250 && s.humidity == 455);
+
+  // One slow loop() during the start pulse (the 4th poll ends the 1 ms
+  // pull-up and starts the pulse, the 5th comes 25 ms later): the pulse is
+  // resent and the read still succeeds
+  hostMicros += 2500000;
+  setFrame(261, 470);
+  dht.resetStats();
+  runSlowPolls(dht, 4, 1);
+  CHECK(dht.readSample(s));
+  CHECK(s.temperature == 261 && s.humidity == 470);
+  CHECK(dht.getStats().startOverrun == 1);
+  CHECK(dht.getStats().noResponse == 0);
+
+  // A loop() that is always too slow: the attempt fails with its own error
+  // after DHT_START_RESTARTS resent pulses, not as a dead sensor
+  hostMicros += 2500000;
+  dht.resetStats();
+  runSlowPolls(dht, 0, 1000);
+  CHECK(!dht.readSample(s));
+  CHECK(s.status == DHT_ERROR_START_OVERRUN);
+  CHECK(dht.getStats().startOverrun == DHT_START_RESTARTS + 1);
+  CHECK(dht.getStats().noResponse == 0);
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Host test: dhtTemperatureDeci()/dhtHumidityDeci() and the float wrappers
+ * built on them give bit-identical results to the former float decoder, for
+ * every possible temperature and humidity frame of DHT11, DHT12, DHT21 and
+ * DHT22. Accepted differences: the DHT21/22 temperature frame 0x8000
+ * ("minus zero") now reads +0.0 instead of -0.0, and DHT21/22 humidity frames
+ * above 0x7FFF (over 3276.7 %RH, no real reading) decode as DHT_INVALID_DECI.
+ * Such a frame read from the bus, with a valid checksum, fails with
+ * DHT_ERROR_RANGE instead of returning the sentinel as a reading.
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../.. DHT_decode_test.cpp ../../DHT.cpp
+ *     ../../DHT_capture.cpp -o dht_decode_test && ./dht_decode_test
+ */
+
+#include <stdio.h>
+#include "DHT.h"
+
+uint32_t hostMicros = 0;
+void (*hostPinModeHook)(uint8_t pin, uint8_t mode) = NULL;
+int (*hostReadHook)(uint8_t pin) = NULL;
+
+// Former DHT::readTemperature() decoding, in Celsius
+static float floatTemperature(const uint8_t data[5], uint8_t type) {
+  float f = NAN;
+  switch (type) {
+  case DHT11:
+    f = data[2];
+    if (data[3] & 0x80) {
+      f = -1 - f;
+    }
+    f += (data[3] & 0x0f) * 0.1;
+    break;
+  case DHT12:
+    f = data[2];
+    f += (data[3] & 0x0f) * 0.1;
+    if (data[2] & 0x80) {
+      f *= -1;
+    }
+    break;
+  case DHT22:
+  case DHT21:
+    f = ((uint16_t)(data[2] & 0x7F)) << 8 | data[3];
+    f *= 0.1;
+    if (data[2] & 0x80) {
+      f *= -1;
+    }
+    break;
+  }
+  return f;
+}
+
+// Former DHT::readHumidity() decoding
+static float floatHumidity(const uint8_t data[5], uint8_t type) {
+  float f = NAN;
+  switch (type) {
+  case DHT11:
+  case DHT12:
+    f = data[0] + data[1] * 0.1;
+    break;
+  case DHT22:
+  case DHT21:
+    f = ((uint16_t)data[0]) << 8 | data[1];
+    f *= 0.1;
+    break;
+  }
+  return f;
+}
+
+// Simulated sensor: sends `frame` after every start pulse. Every
+// digitalRead() takes 1 us, so loop cycles equal microseconds.
+static uint8_t frame[5];
+static bool lineLowNow = false;
+static uint32_t releasedAt = 0;
+
+static void pinModeHook(uint8_t, uint8_t mode) {
+  if (mode == OUTPUT) {
+    lineLowNow = true;
+  } else if (lineLowNow) {
+    lineLowNow = false;
+    releasedAt = hostMicros;
+  }
+}
+
+static int readHook(uint8_t) {
+  uint32_t t = hostMicros++ - releasedAt;
+  if (t < 30) {
+    return HIGH;
+  }
+  t -= 30;
+  if (t < 160) {
+    return t < 80 ? LOW : HIGH;
+  }
+  t -= 160;
+  for (uint8_t i = 0; i < 40; i++) {
+    uint32_t high = (frame[i / 8] & (0x80 >> (i % 8))) ? 70 : 26;
+    if (t < 50 + high) {
+      return t < 50 ? LOW : HIGH;
+    }
+    t -= 50 + high;
+  }
+  return t < 50 ? LOW : HIGH;
+}
+
+// Read one frame from the simulated DHT22, 2 s after the previous one
+static bool readFrame(DHT &dht, uint8_t h0, uint8_t h1, DHTSample &s) {
+  frame[0] = h0;
+  frame[1] = h1;
+  frame[2] = 0x00;
+  frame[3] = 0xEB; // 23.5 °C
+  frame[4] = frame[0] + frame[1] + frame[2] + frame[3];
+  hostMicros += 2000000;
+  return dht.readSample(s);
+}
+
+// An undecodable value must fail the read, not pass DHT_INVALID_DECI on
+static int checkRangeError() {
+  int failures = 0;
+  hostPinModeHook = pinModeHook;
+  hostReadHook = readHook;
+  DHT dht(2, DHT22);
+  dht.begin();
+  DHTSample s;
+
+  if (!readFrame(dht, 0x02, 0x8C, s) || s.humidity != 652 ||
+      s.temperature != 235) {
+    printf("FAIL valid frame: status %d, %d / %d\n", s.status, s.temperature,
+           s.humidity);
+    failures++;
+  }
+  if (readFrame(dht, 0x80, 0x00, s) || s.status != DHT_ERROR_RANGE ||
+      s.humidity != DHT_INVALID_DECI || s.temperature != DHT_INVALID_DECI ||
+      dht.getLastError() != DHT_ERROR_RANGE || dht.getStats().range != 1 ||
+      dht.getStats().checksum != 0) {
+    printf("FAIL humidity frame 8000: status %d, %d / %d, range %lu\n",
+           s.status, s.temperature, s.humidity,
+           (unsigned long)dht.getStats().range);
+    failures++;
+  }
+  if (dht.readHumidityDeci(true) != DHT_INVALID_DECI ||
+      dht.getStats().range != 2) {
+    printf("FAIL humidity frame 8000 via readHumidityDeci()\n");
+    failures++;
+  }
+  hostPinModeHook = NULL;
+  hostReadHook = NULL;
+  return failures;
+}
+
+// Same expression as DHT::readTemperature()/readHumidity()
+static float wrapper(int16_t deci) { return deci * 0.1; }
+
+static bool sameBits(float a, float b) { return memcmp(&a, &b, sizeof(a)) == 0; }
+
+int main() {
+  static const uint8_t types[] = {DHT11, DHT12, DHT21, DHT22};
+  long checked = 0;
+  int failures = 0;
+
+  for (uint8_t ti = 0; ti < sizeof(types); ti++) {
+    uint8_t type = types[ti];
+    for (uint32_t v = 0; v <= 0xFFFF; v++) {
+      uint8_t data[5] = {(uint8_t)(v >> 8), (uint8_t)v, (uint8_t)(v >> 8),
+                         (uint8_t)v, 0};
+
+      int16_t t = dhtTemperatureDeci(data, type);
+      float expected = floatTemperature(data, type);
+      bool minusZero = (type == DHT21 || type == DHT22) && v == 0x8000;
+      if (t == DHT_INVALID_DECI ||
+          !(minusZero ? wrapper(t) == expected
+                      : sameBits(wrapper(t), expected))) {
+        printf("FAIL type %u temperature frame %04lx: %d vs %.7g\n", type,
+               (unsigned long)v, t, expected);
+        failures++;
+      }
+
+      int16_t h = dhtHumidityDeci(data, type);
+      expected = floatHumidity(data, type);
+      bool tooHigh = (type == DHT21 || type == DHT22) && v > 0x7FFF;
+      if (tooHigh ? h != DHT_INVALID_DECI
+                  : (h == DHT_INVALID_DECI || !sameBits(wrapper(h), expected))) {
+        printf("FAIL type %u humidity frame %04lx: %d vs %.7g\n", type,
+               (unsigned long)v, h, expected);
+        failures++;
+      }
+      checked += 2;
+      if (failures > 20) {
+        return 1;
+      }
+    }
+  }
+
+  if (failures) {
+    printf("%d of %ld frames differ\n", failures, checked);
+    return 1;
+  }
+  if (checkRangeError()) {
+    return 1;
+  }
+  printf("OK, %ld frames\n", checked);
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Host test: error bounds of the heat index and dew point code over the
+ * sensor range, -40..80 °C and 0..100 %RH in 0.1 steps.
+ *
+ * - computeHeatIndex() against the former pow()-based implementation
+ * - computeHeatIndexDeci() against computeHeatIndex()
+ * - the batch functions against the scalar ones (identical unless the
+ *   compiler contracts to FMA differently in the vectorised loop)
+ * - computeDewPoint() against the Magnus formula in double precision
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../.. DHT_heat_index_test.cpp ../../DHT.cpp
+ *     ../../DHT_capture.cpp -o dht_heat_index_test && ./dht_heat_index_test
+ */
+
+#include <stdio.h>
+#include "DHT.h"
+
+uint32_t hostMicros = 0;
+void (*hostPinModeHook)(uint8_t pin, uint8_t mode) = NULL;
+int (*hostReadHook)(uint8_t pin) = NULL;
+
+#define MAX_HEAT_INDEX_ERROR_F 0.001 // float code vs former code, °F
+#define MAX_DECI_ERROR_C 0.1         // integer code vs float code, °C
+#define MAX_DEW_POINT_ERROR_C 0.001  // float code vs double Magnus, °C
+#define MAX_BATCH_ERROR 0.0001       // batch vs scalar, °C
+
+// Former DHT::computeHeatIndex() in °F (Arduino's abs() macro works on
+// floats, fabs() here)
+static float formerHeatIndexF(float temperature, float percentHumidity) {
+  float hi = 0.5 * (temperature + 61.0 + ((temperature - 68.0) * 1.2) +
+                    (percentHumidity * 0.094));
+
+  if (hi > 79) {
+    hi = -42.379 + 2.04901523 * temperature + 10.14333127 * percentHumidity +
+         -0.22475541 * temperature * percentHumidity +
+         -0.00683783 * pow(temperature, 2) +
+         -0.05481717 * pow(percentHumidity, 2) +
+         0.00122874 * pow(temperature, 2) * percentHumidity +
+         0.00085282 * temperature * pow(percentHumidity, 2) +
+         -0.00000199 * pow(temperature, 2) * pow(percentHumidity, 2);
+
+    if ((percentHumidity < 13) && (temperature >= 80.0) &&
+        (temperature <= 112.0))
+      hi -= ((13.0 - percentHumidity) * 0.25) *
+            sqrt((17.0 - fabs(temperature - 95.0)) * 0.05882);
+
+    else if ((percentHumidity > 85.0) && (temperature >= 80.0) &&
+             (temperature <= 87.0))
+      hi += ((percentHumidity - 85.0) * 0.1) * ((87.0 - temperature) * 0.2);
+  }
+  return hi;
+}
+
+static double magnusDewPoint(double t, double rh) {
+  double gamma = log(rh / 100.0) + (17.62 * t) / (243.12 + t);
+  return (243.12 * gamma) / (17.62 - gamma);
+}
+
+#define STEPS_T 1201 // -40.0 .. 80.0 °C
+#define STEPS_RH 1001 // 0.0 .. 100.0 %RH
+
+int main() {
+  static float t[STEPS_RH], rh[STEPS_RH], hiBatch[STEPS_RH], dpBatch[STEPS_RH];
+  double worstF = 0, worstDeci = 0, worstDew = 0;
+  double worstBatch = 0;
+
+  for (int i = 0; i < STEPS_T; i++) {
+    int16_t tDeci = -400 + i;
+    for (int j = 0; j < STEPS_RH; j++) {
+      t[j] = tDeci * 0.1f;
+      rh[j] = j * 0.1f;
+    }
+    DHT::computeHeatIndexBatch(t, rh, hiBatch, STEPS_RH, false);
+    DHT::computeDewPointBatch(t, rh, dpBatch, STEPS_RH, false);
+
+    for (int j = 0; j < STEPS_RH; j++) {
+      float tf = t[j] * 1.8f + 32.0f;
+      double e = fabs(DHT::computeHeatIndex(tf, rh[j]) -
+                      formerHeatIndexF(tf, rh[j]));
+      if (e > worstF) {
+        worstF = e;
+      }
+
+      float hiC = DHT::computeHeatIndex(t[j], rh[j], false);
+      e = fabs(DHT::computeHeatIndexDeci(tDeci, j) * 0.1 - hiC);
+      if (e > worstDeci) {
+        worstDeci = e;
+      }
+      e = fabs(hiBatch[j] - hiC);
+      if (e > worstBatch) {
+        worstBatch = e;
+      }
+
+      if (j > 0) {
+        float dp = DHT::computeDewPoint(t[j], rh[j], false);
+        e = fabs(dp - magnusDewPoint(t[j], rh[j]));
+        if (e > worstDew) {
+          worstDew = e;
+        }
+        e = fabs(dpBatch[j] - dp);
+        if (e > worstBatch) {
+          worstBatch = e;
+        }
+      }
+    }
+  }
+
+  printf("heat index vs former code: %.5f F\n", worstF);
+  printf("heat index deci vs float:  %.4f C\n", worstDeci);
+  printf("dew point vs double:       %.5f C\n", worstDew);
+  printf("batch vs scalar:           %.5f C\n", worstBatch);
+
+  int failures = 0;
+  if (worstF > MAX_HEAT_INDEX_ERROR_F) {
+    printf("FAIL: heat index error above %.3f F\n", MAX_HEAT_INDEX_ERROR_F);
+    failures++;
+  }
+  if (worstDeci > MAX_DECI_ERROR_C) {
+    printf("FAIL: deci heat index error above %.1f C\n", MAX_DECI_ERROR_C);
+    failures++;
+  }
+  if (worstDew > MAX_DEW_POINT_ERROR_C) {
+    printf("FAIL: dew point error above %.3f C\n", MAX_DEW_POINT_ERROR_C);
+    failures++;
+  }
+  if (worstBatch > MAX_BATCH_ERROR) {
+    printf("FAIL: batch results differ from the scalar ones\n");
+    failures++;
+  }
+  if (failures) {
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
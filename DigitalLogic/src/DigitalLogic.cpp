@@ -4,6 +4,7 @@
  */
 
 #include "DigitalLogic.h"
+#include <GPIOShadow.h>
 
 // ============================================================================
 // LogicGate Implementation
@@ -21,35 +22,37 @@ LogicGate::LogicGate(int pinA, int pinB, LogicGateType type)
 
 void LogicGate::begin() {
     pinMode(_pinA, OUTPUT);
-    digitalWrite(_pinA, LOW);
+    GPIOShadow::forget(_pinA);
+    GPIOShadow::write(_pinA, LOW);
     _stateA = false;
 
     if (_pinB >= 0) {
         pinMode(_pinB, OUTPUT);
-        digitalWrite(_pinB, LOW);
+        GPIOShadow::forget(_pinB);
+        GPIOShadow::write(_pinB, LOW);
         _stateB = false;
     }
 }
 
 void LogicGate::setInputs(bool a, bool b) {
     _stateA = a;
-    digitalWrite(_pinA, a ? HIGH : LOW);
+    GPIOShadow::write(_pinA, a ? HIGH : LOW);
 
     if (_pinB >= 0) {
         _stateB = b;
-        digitalWrite(_pinB, b ? HIGH : LOW);
+        GPIOShadow::write(_pinB, b ? HIGH : LOW);
     }
 }
 
 void LogicGate::setA(bool level) {
     _stateA = level;
-    digitalWrite(_pinA, level ? HIGH : LOW);
+    GPIOShadow::write(_pinA, level ? HIGH : LOW);
 }
 
 void LogicGate::setB(bool level) {
     if (_pinB >= 0) {
         _stateB = level;
-        digitalWrite(_pinB, level ? HIGH : LOW);
+        GPIOShadow::write(_pinB, level ? HIGH : LOW);
     }
 }
 
@@ -86,7 +89,8 @@ ClockGenerator::ClockGenerator(int pin)
 
 void ClockGenerator::begin(unsigned long frequency) {
     pinMode(_pin, OUTPUT);
-    digitalWrite(_pin, LOW);
+    GPIOShadow::forget(_pin);
+    GPIOShadow::write(_pin, LOW);
     _state = false;
     setFrequency(frequency);
 }
@@ -104,20 +108,20 @@ void ClockGenerator::setFrequency(unsigned long frequency) {
 void ClockGenerator::start() {
     _enabled = true;
     _lastToggle = micros();
-    digitalWrite(_pin, LOW);
+    GPIOShadow::write(_pin, LOW);
     _state = false;
 }
 
 void ClockGenerator::stop() {
     _enabled = false;
-    digitalWrite(_pin, LOW);
+    GPIOShadow::write(_pin, LOW);
     _state = false;
 }
 
 void ClockGenerator::pulse() {
-    digitalWrite(_pin, HIGH);
+    GPIOShadow::write(_pin, HIGH);
     delayMicroseconds(100); // Short high pulse
-    digitalWrite(_pin, LOW);
+    GPIOShadow::write(_pin, LOW);
     _state = false;
 }
 
@@ -129,7 +133,7 @@ void ClockGenerator::update() {
 
     if (currentTime - _lastToggle >= halfPeriod) {
         _state = !_state;
-        digitalWrite(_pin, _state ? HIGH : LOW);
+        GPIOShadow::write(_pin, _state ? HIGH : LOW);
         _lastToggle = currentTime;
     }
 }
@@ -150,25 +154,31 @@ BCDEncoder::BCDEncoder(int pinA, int pinB, int pinC, int pinD, int pinLT, int pi
 
 void BCDEncoder::begin() {
     pinMode(_pinA, OUTPUT);
+    GPIOShadow::forget(_pinA);
     pinMode(_pinB, OUTPUT);
+    GPIOShadow::forget(_pinB);
     pinMode(_pinC, OUTPUT);
+    GPIOShadow::forget(_pinC);
     pinMode(_pinD, OUTPUT);
+    GPIOShadow::forget(_pinD);
 
     // Initialize all BCD pins to LOW (digit 0)
-    digitalWrite(_pinA, LOW);
-    digitalWrite(_pinB, LOW);
-    digitalWrite(_pinC, LOW);
-    digitalWrite(_pinD, LOW);
+    GPIOShadow::write(_pinA, LOW);
+    GPIOShadow::write(_pinB, LOW);
+    GPIOShadow::write(_pinC, LOW);
+    GPIOShadow::write(_pinD, LOW);
 
     // Initialize control pins if available
     if (_pinLT >= 0) {
         pinMode(_pinLT, OUTPUT);
-        digitalWrite(_pinLT, HIGH); // Lamp test inactive (active LOW)
+        GPIOShadow::forget(_pinLT);
+        GPIOShadow::write(_pinLT, HIGH); // Lamp test inactive (active LOW)
     }
 
     if (_pinBI >= 0) {
         pinMode(_pinBI, OUTPUT);
-        digitalWrite(_pinBI, HIGH); // Blanking inactive (active LOW)
+        GPIOShadow::forget(_pinBI);
+        GPIOShadow::write(_pinBI, HIGH); // Blanking inactive (active LOW)
     }
 
     _currentDigit = 0;
@@ -180,10 +190,10 @@ void BCDEncoder::displayDigit(uint8_t digit) {
     _currentDigit = digit;
 
     // Output BCD value to pins
-    digitalWrite(_pinA, (digit & 0x01) ? HIGH : LOW);  // Bit 0 (LSB)
-    digitalWrite(_pinB, (digit & 0x02) ? HIGH : LOW);  // Bit 1
-    digitalWrite(_pinC, (digit & 0x04) ? HIGH : LOW);  // Bit 2
-    digitalWrite(_pinD, (digit & 0x08) ? HIGH : LOW);  // Bit 3 (MSB)
+    GPIOShadow::write(_pinA, (digit & 0x01) ? HIGH : LOW);  // Bit 0 (LSB)
+    GPIOShadow::write(_pinB, (digit & 0x02) ? HIGH : LOW);  // Bit 1
+    GPIOShadow::write(_pinC, (digit & 0x04) ? HIGH : LOW);  // Bit 2
+    GPIOShadow::write(_pinD, (digit & 0x08) ? HIGH : LOW);  // Bit 3 (MSB)
 }
 
 void BCDEncoder::clear() {
@@ -192,19 +202,19 @@ void BCDEncoder::clear() {
     
     // Method 2: If BI pin available, use blanking
     if (_pinBI >= 0) {
-        digitalWrite(_pinBI, LOW); // Active LOW blanking
+        GPIOShadow::write(_pinBI, LOW); // Active LOW blanking
     }
 }
 
 void BCDEncoder::lampTest() {
     if (_pinLT >= 0) {
-        digitalWrite(_pinLT, LOW); // Active LOW lamp test
+        GPIOShadow::write(_pinLT, LOW); // Active LOW lamp test
     }
 }
 
 void BCDEncoder::endLampTest() {
     if (_pinLT >= 0) {
-        digitalWrite(_pinLT, HIGH); // Deactivate lamp test
+        GPIOShadow::write(_pinLT, HIGH); // Deactivate lamp test
     }
 }
 
@@ -231,15 +241,17 @@ void CounterController::begin(unsigned long frequency) {
     _clock->begin(frequency);
     
     pinMode(_resetPin, OUTPUT);
-    digitalWrite(_resetPin, LOW); // Reset inactive
+    
+    GPIOShadow::forget(_resetPin);
+    GPIOShadow::write(_resetPin, LOW); // Reset inactive
 }
 
 void CounterController::reset() {
     // 7493 reset requires R0(1) AND R0(2) to be HIGH
     // Most common connection: both reset pins tied together
-    digitalWrite(_resetPin, HIGH);
+    GPIOShadow::write(_resetPin, HIGH);
     delay(10); // Hold reset for 10ms
-    digitalWrite(_resetPin, LOW);
+    GPIOShadow::write(_resetPin, LOW);
 }
 
 void CounterController::start() {
@@ -339,39 +351,41 @@ void SevenSegmentMultiplex::begin() {
     // Initialize segment pins
     for (int i = 0; i < 7; i++) {
         pinMode(_segmentPins[i], OUTPUT);
-        digitalWrite(_segmentPins[i], LOW);
+        GPIOShadow::forget(_segmentPins[i]);
+        GPIOShadow::write(_segmentPins[i], LOW);
     }
     
     // Initialize digit control pins
     for (int i = 0; i < _numDigits; i++) {
         pinMode(_digitPins[i], OUTPUT);
+        GPIOShadow::forget(_digitPins[i]);
         // Turn off all digits initially
-        digitalWrite(_digitPins[i], _commonCathode ? HIGH : LOW);
+        GPIOShadow::write(_digitPins[i], _commonCathode ? HIGH : LOW);
     }
 }
 
 void SevenSegmentMultiplex::clearDisplay() {
     // Turn off all digits
     for (int i = 0; i < _numDigits; i++) {
-        digitalWrite(_digitPins[i], _commonCathode ? HIGH : LOW);
+        GPIOShadow::write(_digitPins[i], _commonCathode ? HIGH : LOW);
     }
     
     // Turn off all segments
     for (int i = 0; i < 7; i++) {
-        digitalWrite(_segmentPins[i], LOW);
+        GPIOShadow::write(_segmentPins[i], LOW);
     }
 }
 
 void SevenSegmentMultiplex::displayDigit(int8_t digit) {
     // Turn off all digits first
     for (int i = 0; i < _numDigits; i++) {
-        digitalWrite(_digitPins[i], _commonCathode ? HIGH : LOW);
+        GPIOShadow::write(_digitPins[i], _commonCathode ? HIGH : LOW);
     }
     
     // If digit is -1 (blank), keep segments off
     if (digit < 0 || digit > 9) {
         for (int i = 0; i < 7; i++) {
-            digitalWrite(_segmentPins[i], LOW);
+            GPIOShadow::write(_segmentPins[i], LOW);
         }
         return;
     }
@@ -379,11 +393,11 @@ void SevenSegmentMultiplex::displayDigit(int8_t digit) {
     // Set segment pattern for this digit
     for (int i = 0; i < 7; i++) {
         bool segmentOn = SEGMENT_PATTERNS[digit][i];
-        digitalWrite(_segmentPins[i], segmentOn ? HIGH : LOW);
+        GPIOShadow::write(_segmentPins[i], segmentOn ? HIGH : LOW);
     }
     
     // Turn on current digit
-    digitalWrite(_digitPins[_currentDigit], _commonCathode ? LOW : HIGH);
+    GPIOShadow::write(_digitPins[_currentDigit], _commonCathode ? LOW : HIGH);
 }
 
 void SevenSegmentMultiplex::update() {
@@ -504,3 +518,15 @@ void SevenSegmentMultiplex::showTemperature(float temperature, uint8_t decimals)
     
     _displayValue = (uint16_t)tempInt;
 }
+
+void SevenSegmentMultiplex::showTemperatureDeci(int16_t tenths) {
+    if (tenths < 0) tenths = 0;
+    
+    if (_numDigits == 4) {
+        setDecimalPoint(2, true); // XX.X format
+    } else {
+        setDecimalPoint(0, true); // X.X format
+    }
+    
+    _displayValue = (uint16_t)tenths;
+}
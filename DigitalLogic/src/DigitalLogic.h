@@ -484,6 +484,13 @@ public:
      * @param decimals Number of decimal places (0-2)
      */
     void showTemperature(float temperature, uint8_t decimals = 1);
+    
+    /**
+     * @brief Display a value given in tenths with one decimal (e.g., 275 shows 27.5)
+     * Integer only, matches DHT::readTemperatureDeci() / readHumidityDeci()
+     * @param tenths Value in tenths (negative values show 0)
+     */
+    void showTemperatureDeci(int16_t tenths);
 };
 
 #endif // DIGITALLOGIC_H
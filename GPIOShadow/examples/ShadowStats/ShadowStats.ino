@@ -0,0 +1,46 @@
+/*
+ * ShadowStats
+ *
+ * Re-applies relay and LED states every 100 ms (like a control task does)
+ * and prints how many GPIO writes actually reached the pins.
+ *
+ * Hardware:
+ * - Relay module on pin 26
+ * - LED on pin 2
+ */
+
+#include <GPIOShadow.h>
+#include <RelayController.h>
+#include <LEDController.h>
+
+RelayController fan(26);
+LEDController statusLed(2);
+
+unsigned long lastReport = 0;
+
+void setup() {
+  Serial.begin(115200);
+  fan.begin();
+  statusLed.begin();
+}
+
+void loop() {
+  // Same state most of the time: only the changes reach the pins
+  bool fanOn = (millis() / 10000) % 2;
+  fan.setState(fanOn);
+  if (fanOn) {
+    statusLed.on();
+  } else {
+    statusLed.off();
+  }
+
+  if (millis() - lastReport >= 5000) {
+    lastReport = millis();
+    Serial.print("GPIO writes issued: ");
+    Serial.print(GPIOShadow::issuedWrites());
+    Serial.print(" | elided: ");
+    Serial.println(GPIOShadow::elidedWrites());
+  }
+
+  delay(100);
+}
@@ -0,0 +1,58 @@
+#include "GPIOShadow.h"
+
+#define SHADOW_UNKNOWN 0
+#define SHADOW_LOW     1
+#define SHADOW_HIGH    2
+
+uint8_t GPIOShadow::levels[GPIO_SHADOW_PINS] = { 0 };
+volatile uint32_t GPIOShadow::issued = 0;
+volatile uint32_t GPIOShadow::elided = 0;
+
+bool GPIOShadow::write(uint8_t pin, uint8_t level) {
+  uint8_t wanted = (level == LOW) ? SHADOW_LOW : SHADOW_HIGH;
+
+  if (pin < GPIO_SHADOW_PINS) {
+    if (levels[pin] == wanted) {
+      elided = elided + 1;
+      return false;
+    }
+    levels[pin] = wanted;
+  }
+
+  digitalWrite(pin, level);
+  issued = issued + 1;
+  return true;
+}
+
+void GPIOShadow::record(uint8_t pin, uint8_t level) {
+  if (pin < GPIO_SHADOW_PINS) {
+    levels[pin] = (level == LOW) ? SHADOW_LOW : SHADOW_HIGH;
+  }
+}
+
+void GPIOShadow::forget(uint8_t pin) {
+  if (pin < GPIO_SHADOW_PINS) {
+    levels[pin] = SHADOW_UNKNOWN;
+  }
+}
+
+bool GPIOShadow::isKnown(uint8_t pin) {
+  return pin < GPIO_SHADOW_PINS && levels[pin] != SHADOW_UNKNOWN;
+}
+
+uint8_t GPIOShadow::level(uint8_t pin) {
+  return (pin < GPIO_SHADOW_PINS && levels[pin] == SHADOW_HIGH) ? HIGH : LOW;
+}
+
+uint32_t GPIOShadow::issuedWrites() {
+  return issued;
+}
+
+uint32_t GPIOShadow::elidedWrites() {
+  return elided;
+}
+
+void GPIOShadow::resetStats() {
+  issued = 0;
+  elided = 0;
+}
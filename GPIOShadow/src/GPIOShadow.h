@@ -0,0 +1,91 @@
+#ifndef GPIO_SHADOW_H
+#define GPIO_SHADOW_H
+
+#include <Arduino.h>
+
+// Number of pins tracked. Pins at or above this are always written.
+#ifndef GPIO_SHADOW_PINS
+#if defined(NUM_DIGITAL_PINS)
+#define GPIO_SHADOW_PINS NUM_DIGITAL_PINS
+#else
+#define GPIO_SHADOW_PINS 64
+#endif
+#endif
+
+/**
+ * GPIOShadow
+ * Shared shadow copy of output pin levels used by the output libraries
+ * (RelayController, LEDController, DigitalLogic).
+ *
+ * write() only calls digitalWrite() when the requested level differs from
+ * the last level written to that pin, and counts issued and elided writes.
+ * In steady state most output writes are no-ops, and on some cores each
+ * digitalWrite() costs microseconds (or bus traffic to an I/O expander).
+ *
+ * The shadow only knows about writes that go through it. Call forget()
+ * after pinMode(), analogWrite()/ledcWrite() or any direct digitalWrite()
+ * on a tracked pin so the next write() is always issued.
+ *
+ * RAM: one byte per tracked pin. Each pin has its own byte, so tasks that
+ * drive different pins do not interfere; the counters are statistics only.
+ */
+class GPIOShadow {
+  public:
+    /**
+     * Write a level to a pin unless it already has it
+     * @param pin GPIO pin
+     * @param level HIGH or LOW
+     * @return true if digitalWrite() was issued, false if elided
+     */
+    static bool write(uint8_t pin, uint8_t level);
+
+    /**
+     * Record a level written by other means (e.g. a direct port write)
+     * @param pin GPIO pin
+     * @param level HIGH or LOW
+     */
+    static void record(uint8_t pin, uint8_t level);
+
+    /**
+     * Mark a pin's level as unknown; the next write() is always issued
+     * @param pin GPIO pin
+     */
+    static void forget(uint8_t pin);
+
+    /**
+     * Check whether the shadow knows the pin level
+     * @param pin GPIO pin
+     * @return true if known
+     */
+    static bool isKnown(uint8_t pin);
+
+    /**
+     * Last level written to the pin (LOW if unknown)
+     * @param pin GPIO pin
+     * @return HIGH or LOW
+     */
+    static uint8_t level(uint8_t pin);
+
+    /**
+     * Number of digitalWrite() calls issued through write()
+     */
+    static uint32_t issuedWrites();
+
+    /**
+     * Number of write() calls skipped because the level was unchanged
+     */
+    static uint32_t elidedWrites();
+
+    /**
+     * Reset both counters to zero
+     */
+    static void resetStats();
+
+  private:
+    // 0 = unknown, 1 = LOW, 2 = HIGH
+    static uint8_t levels[GPIO_SHADOW_PINS];
+    static volatile uint32_t issued;
+    static volatile uint32_t elided;
+};
+
+#endif // GPIO_SHADOW_H
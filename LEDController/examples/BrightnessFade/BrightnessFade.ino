@@ -0,0 +1,39 @@
+/*
+ * BrightnessFade
+ *
+ * Gamma-corrected brightness and fades with LEDController.
+ * On ESP32 the fades run in the LEDC fade engine, so loop() is free
+ * while the LED ramps up and down.
+ *
+ * Hardware:
+ * - LED + 220Ω resistor on pin 2 (any PWM-capable pin; other pins
+ *   fall back to software PWM)
+ */
+
+#include <LEDController.h>
+
+LEDController led(2);
+
+bool fadingUp = true;
+
+void setup() {
+  Serial.begin(115200);
+
+  if (led.beginPWM()) {
+    Serial.println("Hardware PWM");
+  } else {
+    Serial.println("Software PWM fallback - keep calling update()");
+  }
+
+  led.fadeTo(255, 1500);
+}
+
+void loop() {
+  led.update();
+
+  if (!led.isFading()) {
+    fadingUp = !fadingUp;
+    led.fadeTo(fadingUp ? 255 : 10, 1500);
+    Serial.println(fadingUp ? "Fade up" : "Fade down");
+  }
+}
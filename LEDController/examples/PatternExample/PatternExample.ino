@@ -0,0 +1,50 @@
+/*
+ * PatternExample
+ *
+ * Plays byte-coded patterns on two LEDs without any extra timers:
+ * - Status LED: heartbeat while OK, "3 short blinks, pause" on error
+ * - Alert LED: SOS in Morse code
+ *
+ * Send 'e' over Serial to toggle the error code on the status LED.
+ *
+ * Hardware:
+ * - LED on pin 2 (status)
+ * - LED on pin 4 (alert)
+ */
+
+#include <LEDController.h>
+
+LEDController statusLed(2);
+LEDController alertLed(4);
+
+// Blink code 3 stored in flash: costs 7 bytes of flash, no RAM
+const uint8_t errorCode3[] PROGMEM = { LED_PAT_BLINK_CODE(3) };
+
+bool errorActive = false;
+
+void setup() {
+  Serial.begin(115200);
+  statusLed.begin();
+  alertLed.begin();
+
+  statusLed.playPattern(LED_PATTERN_HEARTBEAT);
+  alertLed.playPattern(LED_PATTERN_SOS);
+
+  Serial.println("PatternExample started - send 'e' to toggle error code");
+}
+
+void loop() {
+  statusLed.update();
+  alertLed.update();
+
+  if (Serial.available() && Serial.read() == 'e') {
+    errorActive = !errorActive;
+    if (errorActive) {
+      statusLed.playPattern(errorCode3);
+      Serial.println("Error code 3");
+    } else {
+      statusLed.playPattern(LED_PATTERN_HEARTBEAT);
+      Serial.println("Heartbeat");
+    }
+  }
+}
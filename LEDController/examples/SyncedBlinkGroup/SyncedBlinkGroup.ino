@@ -0,0 +1,55 @@
+/*
+ * SyncedBlinkGroup
+ *
+ * A row of warning LEDs that stays in lock-step, plus a chaser.
+ * All LEDs share one time base, so they never drift apart even when
+ * loop() is busy with other work.
+ *
+ * Send 'c' over Serial to switch between "all together" and "chaser".
+ *
+ * Hardware:
+ * - 4 LEDs on pins 25, 26, 27, 14 (220Ω resistors)
+ */
+
+#include <LEDController.h>
+#include <LEDGroup.h>
+
+LEDController led1(25);
+LEDController led2(26);
+LEDController led3(27);
+LEDController led4(14);
+
+LEDGroup row;
+bool chasing = false;
+
+void setup() {
+  Serial.begin(115200);
+
+  led1.begin();
+  led2.begin();
+  led3.begin();
+  led4.begin();
+
+  row.add(led1);
+  row.add(led2);
+  row.add(led3);
+  row.add(led4);
+
+  row.startBlink(400);
+  Serial.println("All together - send 'c' to toggle chaser");
+}
+
+void loop() {
+  row.update();
+
+  if (Serial.available() && Serial.read() == 'c') {
+    chasing = !chasing;
+    if (chasing) {
+      row.startChase(400, 100);
+      Serial.println("Chaser");
+    } else {
+      row.startChase(400, 0);
+      Serial.println("All together");
+    }
+  }
+}
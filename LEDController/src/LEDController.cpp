@@ -1,52 +1,487 @@
 #include "LEDController.h"
+#include <GPIOShadow.h>
+
+// Upper bound on instructions executed per step, so a program without any
+// timed instruction (e.g. a LOOP forever without an ON/OFF step) cannot
+// hang update().
+#define LED_PAT_MAX_STEPS 16
+
+// Gamma 2.8 curve: round(255 * (i / 255) ^ 2.8)
+static const uint8_t LED_GAMMA8[256] PROGMEM = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+    2,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   5,   5,   5,
+    5,   6,   6,   6,   6,   7,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,
+   10,  10,  11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,
+   17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+   25,  26,  27,  27,  28,  29,  29,  30,  31,  32,  32,  33,  34,  35,  35,  36,
+   37,  38,  39,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  50,
+   51,  52,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  66,  67,  68,
+   69,  70,  72,  73,  74,  75,  77,  78,  79,  81,  82,  83,  85,  86,  87,  89,
+   90,  92,  93,  95,  96,  98,  99, 101, 102, 104, 105, 107, 109, 110, 112, 114,
+  115, 117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 135, 137, 138, 140, 142,
+  144, 146, 148, 150, 152, 154, 156, 158, 160, 162, 164, 167, 169, 171, 173, 175,
+  177, 180, 182, 184, 186, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+  215, 218, 220, 223, 225, 228, 231, 233, 236, 239, 241, 244, 247, 249, 252, 255
+};
+
+const uint8_t LED_PATTERN_HEARTBEAT[] PROGMEM = {
+  LED_PAT_ON(2), LED_PAT_OFF(3), LED_PAT_ON(2), LED_PAT_OFF(20),
+  LED_PAT_LOOP(0, 4)
+};
+
+const uint8_t LED_PATTERN_SOS[] PROGMEM = {
+  LED_PAT_TICK(15),                                      // 150 ms Morse unit
+  LED_PAT_ON(1), LED_PAT_OFF(1), LED_PAT_LOOP(3, 2),     // S
+  LED_PAT_OFF(2),
+  LED_PAT_ON(3), LED_PAT_OFF(1), LED_PAT_LOOP(3, 2),     // O
+  LED_PAT_OFF(2),
+  LED_PAT_ON(1), LED_PAT_OFF(1), LED_PAT_LOOP(3, 2),     // S
+  LED_PAT_OFF(6),
+  LED_PAT_LOOP(0, 15)
+};
+
+const uint8_t LED_PATTERN_BREATHE[] PROGMEM = {
+  LED_PAT_FADE_IN(20), LED_PAT_FADE_OUT(20), LED_PAT_OFF(10),
+  LED_PAT_LOOP(0, 3)
+};
 
 LEDController::LEDController(uint8_t pinNumber)
-: pin(pinNumber), state(false), blinking(false), interval(500), lastToggle(0) {
+: pin(pinNumber), state(false), blinking(false), interval(500), lastToggle(0),
+  pattern(nullptr), ticksLeft(0), loopCount(0),
+  pwmMode(PWM_NONE), brightness(255), level(0), duty(0), fadeFrom(0), fadeTarget(0),
+  fading(false), hwBlink(false), softLevel(false), analogDriven(false)
+#if defined(ESP32)
+  , pwmResolution(8), pwmFrequency(5000)
+#endif
+{
 }
 
+#if defined(ESP32)
+LEDController* LEDController::hwBlinkOwner = nullptr;
+
+// LEDC timer clock (APB) and the largest integer divider it accepts
+#define LED_LEDC_CLOCK_HZ 80000000UL
+#define LED_LEDC_MAX_DIVIDER 1023UL
+#endif
+
 void LEDController::begin() {
   pinMode(pin, OUTPUT);
+  GPIOShadow::forget(pin);
   off();
 }
 
+bool LEDController::beginPWM(uint32_t frequency, uint8_t resolution) {
+  pinMode(pin, OUTPUT);
+#if defined(ESP32)
+  pwmFrequency = frequency;
+  pwmResolution = resolution;
+  pwmMode = ledcAttach(pin, frequency, resolution) ? PWM_HARDWARE : PWM_SOFTWARE;
+#elif defined(__AVR__)
+  // Frequency and resolution are fixed by the core's timer setup
+  (void)frequency;
+  (void)resolution;
+  pwmMode = (digitalPinToTimer(pin) != NOT_ON_TIMER) ? PWM_HARDWARE : PWM_SOFTWARE;
+#else
+  (void)frequency;
+  (void)resolution;
+  pwmMode = PWM_HARDWARE; // analogWrite()
+#endif
+  GPIOShadow::forget(pin);
+  off();
+  return pwmMode == PWM_HARDWARE;
+}
+
 void LEDController::on() {
+  cancelEffects();
   state = true;
-  blinking = false;
-  digitalWrite(pin, HIGH);
+  writeLevel(brightness);
 }
 
 void LEDController::off() {
+  cancelEffects();
   state = false;
-  blinking = false;
-  digitalWrite(pin, LOW);
+  writeLevel(0);
 }
 
 void LEDController::toggle() {
-  state = !state;
-  blinking = false;
-  digitalWrite(pin, state ? HIGH : LOW);
+  if (state) {
+    off();
+  } else {
+    on();
+  }
 }
 
 void LEDController::startBlink(unsigned long ms) {
+  cancelEffects();
   interval = ms;
+
+#if defined(ESP32)
+  if (startHardwareBlink(ms)) {
+    return;
+  }
+#endif
+
   blinking = true;
   lastToggle = millis();
 }
 
+#if defined(ESP32)
+// A blink is a square wave: let LEDC generate it when the period maps to a
+// whole frequency (interval dividing 500 ms). It gets its own channel pair,
+// so retuning the timer does not touch the PWM of any other LED.
+bool LEDController::startHardwareBlink(unsigned long ms) {
+  if (pwmMode != PWM_HARDWARE || ms == 0 || ms > 500 || (500 % ms) != 0 ||
+      hwBlinkOwner != nullptr) {
+    return false;
+  }
+  uint32_t frequency = 500 / ms;
+
+  // Lowest resolution at which the divider reaches the frequency
+  uint8_t bits = 1;
+  while (bits < SOC_LEDC_TIMER_BIT_WIDTH &&
+         (LED_LEDC_CLOCK_HZ >> bits) / frequency > LED_LEDC_MAX_DIVIDER) {
+    bits++;
+  }
+  if ((LED_LEDC_CLOCK_HZ >> bits) / frequency > LED_LEDC_MAX_DIVIDER) {
+    return false; // too slow for this chip's LEDC timers
+  }
+
+  ledcDetach(pin);
+  if (!ledcAttachChannel(pin, frequency, bits, LED_BLINK_LEDC_CHANNEL)) {
+    ledcAttach(pin, pwmFrequency, pwmResolution);
+    return false;
+  }
+  ledcWrite(pin, 1UL << (bits - 1)); // 50% duty
+  GPIOShadow::forget(pin);
+  hwBlinkOwner = this;
+  hwBlink = true;
+  state = true;
+  return true;
+}
+#endif
+
+void LEDController::startBlinkSynced(unsigned long ms, unsigned long phaseMs) {
+  cancelEffects();
+  if (ms == 0) {
+    ms = 1;
+  }
+  interval = ms;
+  blinking = true;
+
+  // Snap to the last boundary of the shared time base. Signed, so a phase
+  // in the future or a millis() rollover lands on the same on/off cycle.
+  unsigned long now = millis();
+  long period = (long)(2 * ms);
+  long offset = (long)(now - phaseMs) % period;
+  if (offset < 0) {
+    offset += period;
+  }
+  lastToggle = now - ((unsigned long)offset % ms);
+  state = (unsigned long)offset < ms;
+  writeLevel(state ? brightness : 0);
+}
+
 void LEDController::stopBlink() {
+  if (hwBlink) {
+    cancelEffects();
+  }
+  blinking = false;
+  writeLevel(state ? brightness : 0);
+}
+
+void LEDController::playPattern(const uint8_t* program, unsigned long tickMs) {
+  cancelEffects();
+  interval = tickMs ? tickMs : 1;
+  loopCount = 0;
+  pattern = program;
+  lastToggle = millis();
+  stepPattern();
+}
+
+void LEDController::stopPattern() {
+  pattern = nullptr;
+  state = false;
+  writeLevel(0);
+}
+
+bool LEDController::isPlaying() const {
+  return pattern != nullptr;
+}
+
+void LEDController::setBrightness(uint8_t value) {
+  cancelEffects();
+  if (value > 0) {
+    brightness = value;
+  }
+  state = value > 0;
+  writeLevel(value);
+}
+
+uint8_t LEDController::getBrightness() const {
+  return level;
+}
+
+void LEDController::fadeTo(uint8_t value, unsigned long ms) {
+  cancelEffects();
+  if (value > 0) {
+    brightness = value;
+  }
+  state = value > 0;
+
+  if (ms == 0 || value == level) {
+    writeLevel(value);
+    return;
+  }
+
+  fadeFrom = level;
+  fadeTarget = value;
+  interval = ms;
+  lastToggle = millis();
+  fading = true;
+
+#if defined(ESP32)
+  if (pwmMode == PWM_HARDWARE) {
+    // Hand the ramp to the LEDC fade engine (linear in duty)
+    uint32_t maxDuty = (1UL << pwmResolution) - 1;
+    uint8_t targetDuty = gamma(value);
+    GPIOShadow::forget(pin);
+    if (ledcFade(pin, (duty * maxDuty) / 255, (targetDuty * maxDuty) / 255, (int)ms)) {
+      level = value;
+      duty = targetDuty;
+    }
+  }
+#endif
+}
+
+bool LEDController::isFading() const {
+  return fading && (millis() - lastToggle < interval);
+}
+
+LEDController::PwmMode LEDController::getPwmMode() const {
+  return (PwmMode)pwmMode;
+}
+
+uint8_t LEDController::gamma(uint8_t value) {
+  return pgm_read_byte(&LED_GAMMA8[value]);
+}
+
+void LEDController::cancelEffects() {
   blinking = false;
-  digitalWrite(pin, state ? HIGH : LOW);
+  pattern = nullptr;
+  fading = false;
+#if defined(ESP32)
+  if (hwBlink) {
+    // Back from the blink channel to a regular one; the caller writes the level
+    ledcDetach(pin);
+    ledcAttach(pin, pwmFrequency, pwmResolution);
+    hwBlinkOwner = nullptr;
+  }
+#endif
+  hwBlink = false;
+}
+
+void LEDController::writeLevel(uint8_t newLevel) {
+  level = newLevel;
+  writeDuty(gamma(newLevel));
+}
+
+void LEDController::writeDuty(uint8_t newDuty) {
+  duty = newDuty;
+
+  switch (pwmMode) {
+    case PWM_HARDWARE:
+#if defined(ESP32)
+      ledcWrite(pin, (newDuty * ((1UL << pwmResolution) - 1)) / 255);
+#else
+      analogWrite(pin, newDuty);
+#endif
+      GPIOShadow::forget(pin);
+      break;
+
+    case PWM_SOFTWARE:
+      // Full on/off are written here, everything in between by update()
+      if (newDuty == 0 || newDuty == 255) {
+        softLevel = newDuty != 0;
+        GPIOShadow::write(pin, softLevel ? HIGH : LOW);
+      }
+      break;
+
+    default:
+      if (newDuty == 0 || newDuty == 255) {
+#if defined(ESP32)
+        if (analogDriven) {
+          // analogWrite() routed the pin to LEDC, which makes digitalWrite()
+          // fail ("IO n is not set as GPIO"): hand it back to the GPIO matrix
+          ledcDetach(pin);
+          pinMode(pin, OUTPUT);
+        }
+#endif
+        // (on AVR, digitalWrite() disconnects the timer output itself)
+        analogDriven = false;
+        GPIOShadow::write(pin, newDuty ? HIGH : LOW);
+      } else {
+        analogWrite(pin, newDuty);
+        analogDriven = true;
+        GPIOShadow::forget(pin);
+      }
+      break;
+  }
+}
+
+// Execute instructions until the next timed one (ON/OFF/FADE) or END.
+void LEDController::stepPattern() {
+  for (uint8_t steps = 0; steps < LED_PAT_MAX_STEPS; steps++) {
+    uint8_t op = pgm_read_byte(pattern);
+    uint8_t arg = op & LED_PAT_ARG_MASK;
+
+    switch (op & LED_PAT_OP_MASK) {
+      case LED_PAT_OP_ON:
+      case LED_PAT_OP_OFF:
+      case LED_PAT_OP_FADE_IN:
+      case LED_PAT_OP_FADE_OUT:
+        pattern++;
+        if (arg == 0) {
+          continue; // zero-length step, skip
+        }
+        ticksLeft = arg;
+        state = (op & LED_PAT_OP_MASK) == LED_PAT_OP_ON ||
+                (op & LED_PAT_OP_MASK) == LED_PAT_OP_FADE_OUT;
+        writeLevel(state ? brightness : 0);
+        return;
+
+      case LED_PAT_OP_TICK:
+        if (arg > 0) {
+          interval = arg * 10UL;
+        }
+        pattern++;
+        continue;
+
+      case LED_PAT_OP_LOOP: {
+        uint8_t back = pgm_read_byte(pattern + 1);
+        bool jump;
+        if (arg == 0) {
+          jump = true; // forever
+        } else {
+          if (loopCount == 0) {
+            loopCount = arg; // first time through: arm the counter
+          }
+          jump = (--loopCount != 0);
+        }
+        pattern = jump ? pattern - back : pattern + 2;
+        continue;
+      }
+
+      case LED_PAT_OP_END:
+      default:
+        break;
+    }
+    break;
+  }
+
+  // END, unknown opcode or runaway program: stop with the LED off
+  pattern = nullptr;
+  state = false;
+  writeLevel(0);
+}
+
+void LEDController::updatePattern() {
+  unsigned long now = millis();
+
+  // Advance by whole ticks; lastToggle moves in fixed steps so timing
+  // does not drift when update() is called late.
+  while (pattern != nullptr && now - lastToggle >= interval) {
+    lastToggle += interval;
+    if (--ticksLeft == 0) {
+      stepPattern();
+    }
+  }
+
+  if (pattern == nullptr) {
+    return;
+  }
+
+  // The instruction being executed is the byte just before the pointer
+  uint8_t op = pgm_read_byte(pattern - 1);
+  uint8_t kind = op & LED_PAT_OP_MASK;
+  if (kind == LED_PAT_OP_FADE_IN || kind == LED_PAT_OP_FADE_OUT) {
+    unsigned long total = (op & LED_PAT_ARG_MASK) * interval;
+    unsigned long elapsed = ((op & LED_PAT_ARG_MASK) - ticksLeft) * interval + (now - lastToggle);
+    uint8_t ramp = (uint8_t)((elapsed * brightness) / total);
+    writeLevel(kind == LED_PAT_OP_FADE_IN ? ramp : brightness - ramp);
+  }
+}
+
+void LEDController::updateFade() {
+  unsigned long elapsed = millis() - lastToggle;
+  if (elapsed >= interval) {
+    fading = false;
+    if (level != fadeTarget) {
+      writeLevel(fadeTarget);
+    }
+    return;
+  }
+
+  if (level == fadeTarget) {
+    return; // hardware fade: the peripheral is doing the work
+  }
+
+  int32_t span = (int32_t)fadeTarget - (int32_t)fadeFrom;
+  uint8_t next = (uint8_t)(fadeFrom + (span * (int32_t)elapsed) / (int32_t)interval);
+  if (next != level) {
+    writeLevel(next);
+  }
+}
+
+void LEDController::updateSoftPWM() {
+  if (duty == 0 || duty == 255) {
+    return;
+  }
+  bool high = (micros() % LED_SOFT_PWM_PERIOD_US) < (duty * LED_SOFT_PWM_PERIOD_US) / 255;
+  if (high != softLevel) {
+    softLevel = high;
+    GPIOShadow::write(pin, high ? HIGH : LOW);
+  }
+}
+
+// Advance the blink phase accumulator. lastToggle only ever moves by whole
+// intervals, so a late update() does not shift later toggles. Returns true
+// if the LED level changed.
+bool LEDController::advanceBlink(unsigned long now) {
+  unsigned long elapsed = now - lastToggle;
+  if (elapsed < interval) {
+    return false;
+  }
+  if (interval == 0) {
+    lastToggle = now;
+    state = !state;
+    return true;
+  }
+
+  unsigned long steps = elapsed / interval;
+  lastToggle += steps * interval;
+  if (steps & 1) {
+    state = !state;
+    return true;
+  }
+  return false;
 }
 
 void LEDController::update() {
-  if (blinking) {
-    unsigned long now = millis();
-    if (now - lastToggle >= interval) {
-      lastToggle = now;
-      state = !state;
-      digitalWrite(pin, state ? HIGH : LOW);
+  if (pattern != nullptr) {
+    updatePattern();
+  } else if (fading) {
+    updateFade();
+  } else if (blinking) {
+    if (advanceBlink(millis())) {
+      writeLevel(state ? brightness : 0);
     }
   }
+
+  if (pwmMode == PWM_SOFTWARE) {
+    updateSoftPWM();
+  }
 }
 
 bool LEDController::isOn() const {
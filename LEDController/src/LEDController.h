@@ -2,19 +2,91 @@
 #define LED_CONTROLLER_H
 
 #include <Arduino.h>
+#include "LEDPattern.h"
+
+// Software PWM period used on pins without hardware PWM (10 ms = 100 Hz)
+#ifndef LED_SOFT_PWM_PERIOD_US
+#define LED_SOFT_PWM_PERIOD_US 10000UL
+#endif
+
+#if defined(ESP32)
+#include "soc/soc_caps.h"
+
+// LEDC channel for hardware blinks. The blink retunes the channel's timer,
+// which it shares with the next channel (timer = channel / 2), so the pair
+// LED_BLINK_LEDC_CHANNEL, +1 must be left to it: by default the last pair,
+// which ledcAttach() only hands out when every other channel is in use.
+#ifndef LED_BLINK_LEDC_CHANNEL
+#if defined(SOC_LEDC_SUPPORT_HS_MODE)
+#define LED_BLINK_LEDC_CHANNEL (SOC_LEDC_CHANNEL_NUM * 2 - 2)
+#else
+#define LED_BLINK_LEDC_CHANNEL (SOC_LEDC_CHANNEL_NUM - 2)
+#endif
+#endif
+#endif
 
 /**
  * LEDController
- * A small, single-pin LED controller that supports on/off/toggle and blinking.
+ * A small, single-pin LED controller that supports on/off/toggle, blinking
+ * and byte-coded patterns (see LEDPattern.h).
  * Works on Arduino and ESP32.
+ *
+ * Optional brightness control (beginPWM()):
+ * - ESP32: LEDC peripheral. fadeTo() runs in the LEDC fade engine. One
+ *   blink at a time runs on a reserved LEDC channel pair when the interval
+ *   divides 500 ms (ESP32: 1-500 ms; chips with 14-bit LEDC timers such as
+ *   the S3 and C3: 1-100 ms), so update() has nothing to do while it runs;
+ *   other blinks run in software.
+ * - AVR and others: analogWrite() on timer PWM pins.
+ * - Pins without hardware PWM: software PWM generated from update().
+ * Brightness levels are perceptual (0-255) and gamma corrected.
  */
 class LEDController {
+  friend class LEDGroup;
+
+  public:
+    enum PwmMode {
+      PWM_NONE = 0,     // digital on/off only (begin())
+      PWM_HARDWARE,     // LEDC / timer PWM
+      PWM_SOFTWARE      // bit-banged from update()
+    };
+
   private:
     uint8_t pin;
     bool state;               // current ON/OFF
     bool blinking;            // whether blinking mode is active
-    unsigned long interval;   // blink interval in ms
-    unsigned long lastToggle; // last toggle timestamp
+    unsigned long interval;   // blink interval / fade duration in ms
+    unsigned long lastToggle; // last toggle / fade start timestamp
+    const uint8_t* pattern;   // next pattern instruction (nullptr = no pattern)
+    uint8_t ticksLeft;        // ticks remaining for current pattern instruction
+    uint8_t loopCount;        // passes remaining for the active LED_PAT_LOOP
+
+    uint8_t pwmMode;          // PwmMode
+    uint8_t brightness;       // level used by on() (perceptual 0-255)
+    uint8_t level;            // level currently output
+    uint8_t duty;             // gamma-corrected duty currently output (0-255)
+    uint8_t fadeFrom;         // software fade start level
+    uint8_t fadeTarget;       // fade end level
+    bool fading;              // fade in progress
+    bool hwBlink;             // blink running in the PWM peripheral
+    bool softLevel;           // pin level in software PWM mode
+    bool analogDriven;        // PWM_NONE pin last written with analogWrite()
+#if defined(ESP32)
+    uint8_t pwmResolution;    // LEDC resolution in bits
+    uint32_t pwmFrequency;    // LEDC frequency in Hz
+
+    static LEDController* hwBlinkOwner; // LED on LED_BLINK_LEDC_CHANNEL
+    bool startHardwareBlink(unsigned long ms);
+#endif
+
+    bool advanceBlink(unsigned long now);
+    void writeLevel(uint8_t newLevel);
+    void writeDuty(uint8_t newDuty);
+    void cancelEffects();
+    void stepPattern();
+    void updatePattern();
+    void updateFade();
+    void updateSoftPWM();
 
   public:
     // Create controller for a given pin
@@ -23,6 +95,10 @@ class LEDController {
     // Initialize hardware (call in setup())
     void begin();
 
+    // Initialize with brightness control instead of begin().
+    // Returns true if hardware PWM is used, false for the software fallback.
+    bool beginPWM(uint32_t frequency = 5000, uint8_t resolution = 8);
+
     // Turn LED on (stops blinking)
     void on();
 
@@ -35,10 +111,43 @@ class LEDController {
     // Start blinking with given interval in milliseconds
     void startBlink(unsigned long ms);
 
+    // Start blinking aligned to the shared millis() time base: the LED is on
+    // from phaseMs + 2k*ms to phaseMs + (2k+1)*ms. LEDs started this way with
+    // related intervals toggle on the same boundaries, wherever they started.
+    void startBlinkSynced(unsigned long ms, unsigned long phaseMs = 0);
+
     // Stop blinking, preserve current state
     void stopBlink();
 
-    // Must be called regularly in loop() to handle blinking
+    // Play a byte-coded pattern stored in flash (stops blinking).
+    // tickMs is the length of one pattern tick in milliseconds (0 counts as 1).
+    void playPattern(const uint8_t* program, unsigned long tickMs = 50);
+
+    // Stop the running pattern and turn the LED off
+    void stopPattern();
+
+    // Query whether a pattern is currently playing
+    bool isPlaying() const;
+
+    // Set brightness (0-255, gamma corrected) and turn the LED on at that level
+    void setBrightness(uint8_t value);
+
+    // Brightness currently output (0 when off)
+    uint8_t getBrightness() const;
+
+    // Fade from the current level to `value` over `ms` milliseconds
+    void fadeTo(uint8_t value, unsigned long ms);
+
+    // Query whether a fade is in progress
+    bool isFading() const;
+
+    // Which PWM backend is active
+    PwmMode getPwmMode() const;
+
+    // Gamma 2.8 correction of a perceptual level (0-255)
+    static uint8_t gamma(uint8_t value);
+
+    // Must be called regularly in loop() to handle blinking and patterns
     void update();
 
     // Query whether LED is currently on
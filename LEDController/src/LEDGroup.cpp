@@ -0,0 +1,136 @@
+#include "LEDGroup.h"
+#include <GPIOShadow.h>
+
+#if defined(ESP32)
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#endif
+
+LEDGroup::LEDGroup()
+: count(0) {
+}
+
+bool LEDGroup::add(LEDController& led, unsigned long phaseMs) {
+  if (count >= LED_GROUP_MAX) {
+    return false;
+  }
+  leds[count] = &led;
+  phases[count] = phaseMs;
+  count++;
+  return true;
+}
+
+uint8_t LEDGroup::size() const {
+  return count;
+}
+
+void LEDGroup::startBlink(unsigned long ms) {
+  for (uint8_t i = 0; i < count; i++) {
+    leds[i]->startBlinkSynced(ms, phases[i]);
+  }
+}
+
+void LEDGroup::startChase(unsigned long ms, unsigned long stepMs) {
+  for (uint8_t i = 0; i < count; i++) {
+    phases[i] = i * stepMs;
+  }
+  startBlink(ms);
+}
+
+void LEDGroup::stopBlink() {
+  for (uint8_t i = 0; i < count; i++) {
+    leds[i]->stopBlink();
+  }
+}
+
+void LEDGroup::off() {
+  for (uint8_t i = 0; i < count; i++) {
+    leds[i]->off();
+  }
+}
+
+void LEDGroup::update() {
+  unsigned long now = millis();
+
+#if defined(__AVR__)
+  uint8_t ports[LED_GROUP_MAX];
+  uint8_t setMask[LED_GROUP_MAX];
+  uint8_t clearMask[LED_GROUP_MAX];
+  uint8_t portCount = 0;
+#elif defined(ESP32)
+  uint32_t set0 = 0, clear0 = 0;
+  uint32_t set1 = 0, clear1 = 0;
+#endif
+
+  for (uint8_t i = 0; i < count; i++) {
+    LEDController* led = leds[i];
+
+    // Only plain full-brightness digital blinks can be batched. A pin last
+    // driven by analogWrite() is still routed to the PWM peripheral, which
+    // a port / W1TS write cannot reach; its own update() restores it.
+    if (!led->blinking || led->pwmMode != LEDController::PWM_NONE || led->brightness != 255 ||
+        led->analogDriven) {
+      led->update();
+      continue;
+    }
+    if (!led->advanceBlink(now)) {
+      continue;
+    }
+
+    bool high = led->state;
+    led->level = high ? 255 : 0;
+    led->duty = led->level;
+
+#if defined(__AVR__) || defined(ESP32)
+    GPIOShadow::record(led->pin, high ? HIGH : LOW);
+#endif
+
+#if defined(__AVR__)
+    uint8_t port = digitalPinToPort(led->pin);
+    uint8_t bit = digitalPinToBitMask(led->pin);
+    uint8_t p = 0;
+    while (p < portCount && ports[p] != port) {
+      p++;
+    }
+    if (p == portCount) {
+      ports[p] = port;
+      setMask[p] = 0;
+      clearMask[p] = 0;
+      portCount++;
+    }
+    if (high) {
+      setMask[p] |= bit;
+    } else {
+      clearMask[p] |= bit;
+    }
+#elif defined(ESP32)
+    if (led->pin < 32) {
+      if (high) set0 |= (1UL << led->pin); else clear0 |= (1UL << led->pin);
+    } else {
+      if (high) set1 |= (1UL << (led->pin - 32)); else clear1 |= (1UL << (led->pin - 32));
+    }
+#else
+    GPIOShadow::write(led->pin, high ? HIGH : LOW);
+#endif
+  }
+
+#if defined(__AVR__)
+  for (uint8_t p = 0; p < portCount; p++) {
+    volatile uint8_t* out = portOutputRegister(ports[p]);
+    uint8_t oldSREG = SREG;
+    cli();
+    *out = (*out | setMask[p]) & ~clearMask[p];
+    SREG = oldSREG;
+  }
+#elif defined(ESP32)
+  if (set0) REG_WRITE(GPIO_OUT_W1TS_REG, set0);
+  if (clear0) REG_WRITE(GPIO_OUT_W1TC_REG, clear0);
+#if SOC_GPIO_PIN_COUNT > 32
+  if (set1) REG_WRITE(GPIO_OUT1_W1TS_REG, set1);
+  if (clear1) REG_WRITE(GPIO_OUT1_W1TC_REG, clear1);
+#else
+  (void)set1;
+  (void)clear1;
+#endif
+#endif
+}
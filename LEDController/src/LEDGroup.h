@@ -0,0 +1,74 @@
+#ifndef LED_GROUP_H
+#define LED_GROUP_H
+
+#include <Arduino.h>
+#include "LEDController.h"
+
+#ifndef LED_GROUP_MAX
+#define LED_GROUP_MAX 8
+#endif
+
+/**
+ * LEDGroup
+ * Drives several LEDControllers from one shared time base.
+ *
+ * All members blink on absolute boundaries (see startBlinkSynced()), each
+ * with its own phase offset, so a row of LEDs never drifts apart. Toggles
+ * that fall due in the same update() are collected and written together:
+ * one output register write per port on AVR, one set/clear register pair
+ * on ESP32, digitalWrite() on other boards.
+ *
+ * Members running a pattern, fade or PWM brightness are updated individually.
+ */
+class LEDGroup {
+  private:
+    LEDController* leds[LED_GROUP_MAX];
+    unsigned long phases[LED_GROUP_MAX];  // phase offset per LED in ms
+    uint8_t count;
+
+  public:
+    LEDGroup();
+
+    /**
+     * Add an LED to the group
+     * @param led LED controller (begin() must still be called on it)
+     * @param phaseMs Phase offset of this LED for group blinks
+     * @return false if the group is full
+     */
+    bool add(LEDController& led, unsigned long phaseMs = 0);
+
+    /**
+     * Number of LEDs in the group
+     */
+    uint8_t size() const;
+
+    /**
+     * Blink all LEDs with the same interval, each at its own phase offset
+     * @param ms Blink interval in milliseconds
+     */
+    void startBlink(unsigned long ms);
+
+    /**
+     * Chaser: blink all LEDs, LED i shifted by i * stepMs
+     * @param ms Blink interval in milliseconds
+     * @param stepMs Phase step between neighbouring LEDs
+     */
+    void startChase(unsigned long ms, unsigned long stepMs);
+
+    /**
+     * Stop blinking on all LEDs (each keeps its current state)
+     */
+    void stopBlink();
+
+    /**
+     * Turn all LEDs off
+     */
+    void off();
+
+    /**
+     * Call regularly in loop() instead of update() on each member
+     */
+    void update();
+};
+
+#endif // LED_GROUP_H
@@ -0,0 +1,73 @@
+#ifndef LED_PATTERN_H
+#define LED_PATTERN_H
+
+#include <Arduino.h>
+
+/**
+ * LEDPattern
+ * Byte-coded LED sequences for LEDController::playPattern().
+ *
+ * Every instruction is one byte: the top 3 bits are the opcode and the
+ * low 5 bits are the argument (1-31). Only LED_PAT_LOOP takes a second byte.
+ * The macros check their arguments at compile time, so they need constants.
+ * Programs are meant to live in flash (PROGMEM) and end with LED_PAT_END
+ * or a LED_PAT_LOOP(0, ...) that repeats forever.
+ *
+ * Times are counted in ticks. The tick length is passed to playPattern()
+ * (default 50 ms) and can be changed inside a program with LED_PAT_TICK.
+ *
+ * Example - "3 short blinks, pause", repeated forever:
+ *   const uint8_t code3[] PROGMEM = {
+ *     LED_PAT_ON(4), LED_PAT_OFF(4),  // one short blink
+ *     LED_PAT_LOOP(3, 2),             // 3 times, jump back 2 bytes
+ *     LED_PAT_OFF(20),                // pause
+ *     LED_PAT_LOOP(0, 5)              // forever, jump back to start
+ *   };
+ */
+
+#define LED_PAT_OP_END      0x00  // LED off, pattern finished
+#define LED_PAT_OP_ON       0x20  // LED on for n ticks
+#define LED_PAT_OP_OFF      0x40  // LED off for n ticks
+#define LED_PAT_OP_FADE_IN  0x60  // ramp from off to full over n ticks
+#define LED_PAT_OP_FADE_OUT 0x80  // ramp from full to off over n ticks
+#define LED_PAT_OP_LOOP     0xA0  // repeat: n passes (0 = forever), next byte = jump back distance
+#define LED_PAT_OP_TICK     0xC0  // set tick length to n x 10 ms
+
+#define LED_PAT_OP_MASK     0xE0
+#define LED_PAT_ARG_MASK    0x1F
+
+// Compile-time range check for a constant instruction argument: an
+// out-of-range value stops the build instead of being masked into another
+// (LED_PAT_ON(40) would become ON(8), LED_PAT_LOOP(32, ...) "forever").
+template <long N, long Lo, long Hi>
+struct LedPatArg {
+  static_assert(N >= Lo && N <= Hi, "LED pattern argument out of range");
+  static const uint8_t value = (uint8_t)N;
+};
+
+#define LED_PAT_END               LED_PAT_OP_END
+// ticks / tensOfMs: 1-31
+#define LED_PAT_ON(ticks)         (LED_PAT_OP_ON | LedPatArg<(ticks), 1, 31>::value)
+#define LED_PAT_OFF(ticks)        (LED_PAT_OP_OFF | LedPatArg<(ticks), 1, 31>::value)
+#define LED_PAT_FADE_IN(ticks)    (LED_PAT_OP_FADE_IN | LedPatArg<(ticks), 1, 31>::value)
+#define LED_PAT_FADE_OUT(ticks)   (LED_PAT_OP_FADE_OUT | LedPatArg<(ticks), 1, 31>::value)
+#define LED_PAT_TICK(tensOfMs)    (LED_PAT_OP_TICK | LedPatArg<(tensOfMs), 1, 31>::value)
+
+// Jump back `back` bytes (1-255), counted from this LOOP instruction to the
+// loop target. `passes` is the total number of passes through the loop body
+// (1-31, or 0 = forever). Only one counted loop can be active at a time
+// (loops must not be nested).
+#define LED_PAT_LOOP(passes, back) \
+  (LED_PAT_OP_LOOP | LedPatArg<(passes), 0, 31>::value), LedPatArg<(back), 1, 255>::value
+
+// "count short blinks, pause" forever (default 50 ms tick), count 1-31
+#define LED_PAT_BLINK_CODE(count) \
+  LED_PAT_ON(4), LED_PAT_OFF(4), (LED_PAT_OP_LOOP | LedPatArg<(count), 1, 31>::value), 2, \
+  LED_PAT_OFF(20), LED_PAT_LOOP(0, 5)
+
+// Ready-made programs (stored in flash)
+extern const uint8_t LED_PATTERN_HEARTBEAT[] PROGMEM;
+extern const uint8_t LED_PATTERN_SOS[] PROGMEM;
+extern const uint8_t LED_PATTERN_BREATHE[] PROGMEM;
+
+#endif // LED_PATTERN_H
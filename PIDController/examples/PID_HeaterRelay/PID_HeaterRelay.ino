@@ -0,0 +1,87 @@
+/*
+ * PID_HeaterRelay
+ *
+ * Holds a DHT22 enclosure at 30 °C with a heater on a relay. At start-up
+ * PIDAutoTune makes the temperature oscillate around the setpoint a few
+ * times to measure the process, then PIDController takes over and drives
+ * the relay time-proportionally through RelayPWM (30 s window).
+ *
+ * For a fan instead of a heater use PIDController::REVERSE (in both the
+ * auto-tune and the controller); with a PWM fan, write the output with
+ * analogWrite() instead of switching a relay.
+ *
+ * Hardware (ESP32):
+ * - DHT22 DATA → GPIO 4
+ * - Heater relay (or SSR) → GPIO 26
+ *
+ * Required Libraries:
+ * - TemperatureSensor, RelayController, GPIOShadow
+ * - DHT sensor library by Adafruit, Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+#include <RelayController.h>
+#include <RelayPWM.h>
+#include <PIDController.h>
+#include <PIDAutoTune.h>
+
+const int DHT_PIN = 4;
+const int HEATER_PIN = 26;
+const int16_t SETPOINT = 300;   // 30.0 °C
+
+TemperatureSensor sensor(DHT_PIN, DHT22);
+RelayController heater(HEATER_PIN);
+RelayPWM heaterPWM(30000, 1000);  // 30 s window, 1 s minimum pulse
+int8_t heaterId;
+
+PIDController pid(0, 0, 0, 2000);           // gains from the auto-tune
+PIDAutoTune tune(SETPOINT, 0, 1000, 3, 3);  // ±0.3 °C, 3 cycles
+
+void setup() {
+  Serial.begin(115200);
+  sensor.begin();
+  heater.begin();
+  heaterId = heaterPWM.add(heater);
+  heaterPWM.begin();
+
+  pid.setSetpoint(SETPOINT);
+  tune.start();
+  Serial.println("=== PID heater: auto-tuning ===");
+}
+
+void loop() {
+  heaterPWM.update();
+  sensor.startRead();
+  sensor.poll();
+  if (!sensor.resultReady() || !sensor.isValid()) {
+    return;
+  }
+  int16_t t = sensor.getTemperatureDeci();
+
+  if (tune.isRunning()) {
+    // Relay experiment: heater fully on or off
+    tune.update(t, sensor.getSampleTime());
+    heaterPWM.setDuty(heaterId, tune.getOutput() / 10.0);
+    if (tune.isDone()) {
+      tune.apply(pid);
+      Serial.print("Tuned: Kp=");
+      Serial.print(pid.getKp(), 2);
+      Serial.print("  Ki=");
+      Serial.print(pid.getKi(), 4);
+      Serial.print("  Kd=");
+      Serial.println(pid.getKd(), 2);
+    } else if (tune.isFailed()) {
+      Serial.println("Auto-tune failed, check heater and sensor");
+      heaterPWM.stop();
+    }
+  } else if (tune.isDone() && pid.compute(t, sensor.getSampleTime())) {
+    heaterPWM.setDuty(heaterId, pid.getOutputPercent());
+  }
+
+  Serial.print(tune.isRunning() ? "[tune] " : "[pid]  ");
+  Serial.print("T=");
+  Serial.print(t / 10.0, 1);
+  Serial.print(" °C  heater=");
+  Serial.print(heaterPWM.getDuty(heaterId), 0);
+  Serial.println(" %");
+}
@@ -0,0 +1,220 @@
+/*
+ * PID_SimulatedPlant
+ *
+ * Runs on any board without hardware: a simulated heater (first order,
+ * 20 s dead time, like a small enclosure with a DHT22) is controlled
+ * 1. bang-bang with ±1 °C hysteresis, as in SmartFan_Hysteresis, and
+ * 2. by PIDController through a time-proportional relay (as RelayPWM
+ *    does) with different window lengths, and
+ * 3. by PIDController through the PIDRelayOutput deadband stage (relay ON
+ *    at output 600, OFF at 400).
+ * The gains come from a PIDAutoTune relay experiment on the same plant.
+ *
+ * This runs for two heater sizes: 2x the power needed to hold the setpoint
+ * (50 % duty) and 4x (an oversized heater, where bang-bang overshoots far
+ * above the setpoint). Two simulated hours are computed per run in a
+ * fraction of a second, and the overshoot, the ripple in the second hour
+ * and the relay switches are printed for each controller.
+ */
+
+#include <PIDController.h>
+#include <PIDAutoTune.h>
+#include <PIDRelayOutput.h>
+
+const int16_t SETPOINT = 450;     // 45.0 °C
+const float AMBIENT = 25.0;       // °C
+const float TAU = 300.0;          // s
+const uint8_t DEAD_TIME = 20;     // s
+const unsigned long RUN = 7200;   // s simulated per run
+
+// ---- Simulated plant, 1 s steps ----
+float gain;                       // °C rise at full power
+float temperature;
+uint8_t pipe[DEAD_TIME];          // heater state delayed by the dead time
+uint8_t pipePos;
+
+void plantReset() {
+  temperature = AMBIENT;
+  memset(pipe, 0, sizeof(pipe));
+  pipePos = 0;
+}
+
+void plantStep(bool heaterOn) {
+  uint8_t delayed = pipe[pipePos];
+  pipe[pipePos] = heaterOn;
+  pipePos = (pipePos + 1) % DEAD_TIME;
+  temperature += (gain * delayed - (temperature - AMBIENT)) / TAU;
+}
+
+// DHT22-like reading: tenths, with ±0.1 °C noise
+int16_t plantMeasure() {
+  return (int16_t)(temperature * 10.0 + 0.5) + random(-1, 2);
+}
+
+// ---- Statistics of one run ----
+struct Result {
+  float overshoot;   // °C above the setpoint after first reaching it
+  float ripple;      // peak-to-peak in the second hour, °C
+  unsigned int switches;
+};
+
+Result result;
+bool reached;
+float lateMin, lateMax;
+
+void statsReset() {
+  result.overshoot = 0;
+  result.switches = 0;
+  reached = false;
+  lateMin = 1000;
+  lateMax = -1000;
+}
+
+void statsStep(unsigned long t, bool on, bool wasOn) {
+  if (on && !wasOn) {
+    result.switches++;
+  }
+  float over = temperature - SETPOINT / 10.0;
+  if (over >= 0) {
+    reached = true;
+  }
+  if (reached && over > result.overshoot) {
+    result.overshoot = over;
+  }
+  if (t >= RUN / 2) {
+    lateMin = min(lateMin, temperature);
+    lateMax = max(lateMax, temperature);
+  }
+  result.ripple = lateMax - lateMin;
+}
+
+void printResult(const char* name) {
+  Serial.print(name);
+  Serial.print("overshoot ");
+  Serial.print(result.overshoot, 2);
+  Serial.print(" °C  |  ripple ");
+  Serial.print(result.ripple, 2);
+  Serial.print(" °C  |  relay switches ");
+  Serial.println(result.switches);
+}
+
+// ---- Controllers ----
+void runBangBang(float hysteresis) {
+  plantReset();
+  statsReset();
+  bool on = false;
+  for (unsigned long t = 0; t < RUN; t++) {
+    bool wasOn = on;
+    if (t % 2 == 0) {                    // DHT: one reading per 2 s
+      int16_t m = plantMeasure();
+      if (!on && m < SETPOINT - hysteresis * 10) {
+        on = true;
+      } else if (on && m > SETPOINT + hysteresis * 10) {
+        on = false;
+      }
+    }
+    plantStep(on);
+    statsStep(t, on, wasOn);
+  }
+}
+
+void runPID(PIDController& pid, unsigned long window) {
+  plantReset();
+  statsReset();
+  pid.reset();
+  pid.setSetpoint(SETPOINT);
+  bool on = false;
+  unsigned long onTime = 0;
+  for (unsigned long t = 0; t < RUN; t++) {
+    bool wasOn = on;
+    if (t % 2 == 0) {
+      pid.compute(plantMeasure(), t * 1000);
+    }
+    if (t % window == 0) {               // new window: latch the duty
+      onTime = (unsigned long)(pid.getOutputPercent() * window / 100.0 + 0.5);
+    }
+    on = (t % window) < onTime;
+    plantStep(on);
+    statsStep(t, on, wasOn);
+  }
+}
+
+void runPIDRelay(PIDController& pid, PIDRelayOutput& stage) {
+  plantReset();
+  statsReset();
+  pid.reset();
+  stage.reset();
+  pid.setSetpoint(SETPOINT);
+  for (unsigned long t = 0; t < RUN; t++) {
+    bool wasOn = stage.isOn();
+    if (t % 2 == 0 && pid.compute(plantMeasure(), t * 1000)) {
+      stage.update(pid);
+    }
+    plantStep(stage.isOn());
+    statsStep(t, stage.isOn(), wasOn);
+  }
+}
+
+bool autoTune(PIDAutoTune& tune) {
+  plantReset();
+  tune.start();
+  for (unsigned long t = 0; t < RUN && !tune.isDone() && !tune.isFailed(); t++) {
+    if (t % 2 == 0) {
+      tune.update(plantMeasure(), millis() + t * 1000);
+    }
+    plantStep(tune.getOutput() > 0);
+  }
+  return tune.isDone();
+}
+
+void compare(float fullPowerRise) {
+  gain = fullPowerRise;
+  Serial.print("--- Heater ");
+  Serial.print(gain / (SETPOINT / 10.0 - AMBIENT), 0);
+  Serial.println("x the holding power ---");
+
+  PIDAutoTune tune(SETPOINT, 0, 1000, 3, 3);  // ±0.3 °C relay band
+  if (!autoTune(tune)) {
+    Serial.println("Auto-tune failed");
+    return;
+  }
+  Serial.print("Auto-tune: Ku=");
+  Serial.print(tune.getUltimateGain(), 2);
+  Serial.print("  Tu=");
+  Serial.print(tune.getUltimatePeriod(), 0);
+  Serial.print(" s  ->  Kp=");
+  Serial.print(tune.getKp(), 2);
+  Serial.print("  Ki=");
+  Serial.print(tune.getKi(), 4);
+  Serial.print("  Kd=");
+  Serial.println(tune.getKd(), 2);
+
+  runBangBang(1.0);
+  printResult("Bang-bang ±1 °C       ");
+  runBangBang(0.3);
+  printResult("Bang-bang ±0.3 °C     ");
+
+  PIDController pid(0, 0, 0, 2000);
+  tune.apply(pid);
+  runPID(pid, 30);
+  printResult("PID, 30 s window      ");
+  runPID(pid, 60);
+  printResult("PID, 60 s window      ");
+  runPID(pid, 120);
+  printResult("PID, 120 s window     ");
+  PIDRelayOutput stage(600, 400);
+  runPIDRelay(pid, stage);
+  printResult("PID, deadband 400-600 ");
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+  randomSeed(1);
+  Serial.println("=== PID vs bang-bang on a simulated heater ===");
+  compare(40.0);
+  compare(80.0);
+}
+
+void loop() {
+}
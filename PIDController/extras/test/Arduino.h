@@ -0,0 +1,19 @@
+// Minimal Arduino API for building the library sources on a host (tests only).
+// Time is passed explicitly to compute()/update(); millis() stays at 0.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PI 3.1415926535897932384626433832795
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline unsigned long millis() { return 0; }
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Host simulation of the PID_SimulatedPlant heater, comparing PIDController
+ * with the PIDRelayOutput deadband stage against bang-bang with ±1 °C
+ * hysteresis (setpoint 20 °C above ambient, gains from PIDAutoTune on each
+ * plant, RULE_PI):
+ * - heater 2x the power needed to hold the setpoint (40 °C full-power rise,
+ *   50 % duty): at least on par, i.e. overshoot and mean error within
+ *   0.1 °C and switches within 5 % of bang-bang
+ * - heaters 3-5x (60-100 °C rise, oversized): less overshoot, fewer
+ *   switches and a mean closer to the setpoint
+ *
+ * Also checks that reset() restarts from the minimum output.
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../../src PID_SimulatedPlant_test.cpp
+ *     ../../src/PIDController.cpp ../../src/PIDAutoTune.cpp
+ *     ../../src/PIDRelayOutput.cpp -o pid_test && ./pid_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "PIDController.h"
+#include "PIDAutoTune.h"
+#include "PIDRelayOutput.h"
+
+static const int16_t SETPOINT = 450;      // 45.0 °C
+static const float AMBIENT = 25.0f;
+static const float TAU = 300.0f;          // s
+static const uint8_t DEAD_TIME = 20;      // s
+static const unsigned long RUN = 7200;    // s
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double value) {
+  if (!ok) {
+    printf("FAIL: %s (%.2f)\n", what, value);
+    failures++;
+  }
+}
+
+// Same plant as the example: first order, dead time, 1 s steps, DHT22 noise
+// of ±0.1 °C from a fixed pseudo-random sequence
+static float gain;
+static float temperature;
+static uint8_t pipe[DEAD_TIME];
+static uint8_t pipePos;
+static uint32_t seed;
+
+static void plantReset() {
+  temperature = AMBIENT;
+  memset(pipe, 0, sizeof(pipe));
+  pipePos = 0;
+  seed = 1;
+}
+
+static void plantStep(bool on) {
+  uint8_t delayed = pipe[pipePos];
+  pipe[pipePos] = on;
+  pipePos = (pipePos + 1) % DEAD_TIME;
+  temperature += (gain * delayed - (temperature - AMBIENT)) / TAU;
+}
+
+static int16_t plantMeasure() {
+  seed = seed * 1103515245 + 12345;
+  return (int16_t)(temperature * 10.0f + 0.5f) + (int)((seed >> 16) % 3) - 1;
+}
+
+struct Result {
+  float overshoot;     // °C above the setpoint after first reaching it
+  float mean;          // second hour
+  unsigned switches;   // OFF -> ON transitions
+};
+
+struct Stats {
+  Result r;
+  bool reached;
+  double sum;
+  unsigned long n;
+
+  Stats() : reached(false), sum(0), n(0) {
+    r.overshoot = 0;
+    r.mean = 0;
+    r.switches = 0;
+  }
+
+  void step(unsigned long t, bool on, bool wasOn) {
+    if (on && !wasOn) {
+      r.switches++;
+    }
+    float over = temperature - SETPOINT / 10.0f;
+    if (over >= 0) {
+      reached = true;
+    }
+    if (reached && over > r.overshoot) {
+      r.overshoot = over;
+    }
+    if (t >= RUN / 2) {
+      sum += temperature;
+      n++;
+      r.mean = (float)(sum / n);
+    }
+  }
+};
+
+static Result runBangBang(int16_t hysteresis) {
+  plantReset();
+  Stats s;
+  bool on = false;
+  for (unsigned long t = 0; t < RUN; t++) {
+    bool wasOn = on;
+    if (t % 2 == 0) {
+      int16_t m = plantMeasure();
+      if (!on && m < SETPOINT - hysteresis) {
+        on = true;
+      } else if (on && m > SETPOINT + hysteresis) {
+        on = false;
+      }
+    }
+    plantStep(on);
+    s.step(t, on, wasOn);
+  }
+  return s.r;
+}
+
+static Result runPIDRelay(PIDController& pid, PIDRelayOutput& stage) {
+  plantReset();
+  Stats s;
+  pid.reset();
+  stage.reset();
+  pid.setSetpoint(SETPOINT);
+  for (unsigned long t = 0; t < RUN; t++) {
+    bool wasOn = stage.isOn();
+    if (t % 2 == 0 && pid.compute(plantMeasure(), t * 1000)) {
+      stage.update(pid);
+    }
+    plantStep(stage.isOn());
+    s.step(t, stage.isOn(), wasOn);
+  }
+  return s.r;
+}
+
+static bool autoTune(PIDAutoTune& tune) {
+  plantReset();
+  tune.start();
+  for (unsigned long t = 0; t < RUN && !tune.isDone() && !tune.isFailed(); t++) {
+    if (t % 2 == 0) {
+      tune.update(plantMeasure(), t * 1000);
+    }
+    plantStep(tune.getOutput() > 0);
+  }
+  return tune.isDone();
+}
+
+static void comparePlant(float fullPowerRise, bool oversized) {
+  gain = fullPowerRise;
+  PIDAutoTune tune(SETPOINT, 0, 1000, 3, 3);
+  if (!autoTune(tune)) {
+    check(false, "auto-tune failed", gain);
+    return;
+  }
+  PIDController pid(0, 0, 0, 2000);
+  tune.apply(pid);
+  PIDRelayOutput stage(600, 400);
+
+  Result bang = runBangBang(10);
+  Result pidRelay = runPIDRelay(pid, stage);
+  printf("Heater %.0fx  bang-bang ±1 °C: overshoot %.2f, %u switches, mean %.2f"
+         "  |  PID + deadband: overshoot %.2f, %u switches, mean %.2f\n",
+         gain / (SETPOINT / 10.0f - AMBIENT), bang.overshoot, bang.switches, bang.mean,
+         pidRelay.overshoot, pidRelay.switches, pidRelay.mean);
+
+  float error = fabsf(pidRelay.mean - SETPOINT / 10.0f);
+  float bangError = fabsf(bang.mean - SETPOINT / 10.0f);
+  check(error < 0.5f, "mean off the setpoint", pidRelay.mean);
+  if (oversized) {
+    check(pidRelay.overshoot < bang.overshoot, "overshoot not below bang-bang", pidRelay.overshoot);
+    check(pidRelay.switches < bang.switches, "switches not below bang-bang", pidRelay.switches);
+    check(error < bangError, "mean not closer to the setpoint", pidRelay.mean);
+  } else {
+    check(pidRelay.overshoot <= bang.overshoot + 0.1f, "overshoot above bang-bang", pidRelay.overshoot);
+    check(pidRelay.switches * 20 <= bang.switches * 21, "switches above bang-bang", pidRelay.switches);
+    check(error <= bangError + 0.1f, "mean further from the setpoint", pidRelay.mean);
+  }
+
+  // A second run on the same objects must start fresh
+  Result again = runPIDRelay(pid, stage);
+  check(again.overshoot == pidRelay.overshoot && again.switches == pidRelay.switches,
+        "second run differs", again.overshoot);
+}
+
+static void checkReset() {
+  PIDController pid(10, 0.1f, 0, 2000);
+  pid.setSetpoint(450);
+  for (unsigned long t = 0; t < 100; t++) {
+    pid.compute(200, t * 2000);
+  }
+  check(pid.getOutput() == 1000, "not saturated before reset", pid.getOutput());
+  pid.reset();
+  check(pid.getOutput() == 0, "reset() keeps the output", pid.getOutput());
+  pid.compute(449, 1000000);
+  check(pid.getOutput() == 10, "first output after reset() not from zero", pid.getOutput());
+
+  pid.setAutomatic(false);
+  pid.setOutput(700);
+  pid.setAutomatic(true);
+  pid.compute(450, 2000000);
+  check(pid.getOutput() == 700, "manual -> automatic not bumpless", pid.getOutput());
+}
+
+int main() {
+  checkReset();
+  comparePlant(40, false);
+  comparePlant(60, true);
+  comparePlant(80, true);
+  comparePlant(100, true);
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include "PIDAutoTune.h"
+
+PIDAutoTune::PIDAutoTune(int16_t setpointDeci, int16_t outputLow, int16_t outputHigh,
+                         uint8_t hysteresisDeci, uint8_t cycleCount, PIDController::Direction dir)
+: setpoint(setpointDeci), outLow(outputLow), outHigh(outputHigh), hysteresis(hysteresisDeci),
+  cycles(constrain(cycleCount, 1, PID_AUTOTUNE_MAX_CYCLES)), direction(dir), timeout(0),
+  running(false), done(false), failed(false), cycling(false), high(false), output(outputLow), ku(0), tu(0) {
+}
+
+void PIDAutoTune::start(unsigned long timeoutMs) {
+  timeout = timeoutMs;
+  running = true;
+  done = false;
+  failed = false;
+  count = 0;
+  sumMax = sumMin = 0;
+  sumPeriod = 0;
+  peakMax = INT16_MIN;
+  peakMin = INT16_MAX;
+  startTime = millis();
+  cycleStart = startTime;
+  cycling = false;
+  high = false;
+  output = outLow;
+  ku = tu = 0;
+}
+
+void PIDAutoTune::cancel() {
+  running = false;
+  output = outLow;
+}
+
+bool PIDAutoTune::update(int16_t input, unsigned long nowMs) {
+  if (!running) {
+    return false;
+  }
+  if (input == INT16_MIN) {
+    return true; // failed read (DHT_INVALID_DECI), keep the output
+  }
+  if ((long)(nowMs - startTime) > (long)timeout) {
+    running = false;
+    failed = true;
+    output = outLow;
+    return false;
+  }
+
+  peakMax = max(peakMax, input);
+  peakMin = min(peakMin, input);
+
+  // Heater: output high below the band, low above it (fan: the reverse)
+  int16_t error = (direction == PIDController::DIRECT) ? setpoint - input : input - setpoint;
+  if (!high && error > hysteresis) {
+    // Switch to high: one full cycle ended here
+    high = true;
+    output = outHigh;
+    if (cycling) {
+      if (count > 0) {
+        // Skip the first cycle (start-up transient)
+        sumMax += peakMax;
+        sumMin += peakMin;
+        sumPeriod += nowMs - cycleStart;
+      }
+      count++;
+      peakMax = INT16_MIN;
+      peakMin = INT16_MAX;
+      if (count > cycles) {
+        finish();
+        return false;
+      }
+    } else {
+      // First switch: the oscillation starts here
+      cycling = true;
+      peakMax = INT16_MIN;
+      peakMin = INT16_MAX;
+    }
+    cycleStart = nowMs;
+  } else if (high && error < -(int16_t)hysteresis) {
+    high = false;
+    output = outLow;
+  }
+  return true;
+}
+
+void PIDAutoTune::finish() {
+  running = false;
+  output = outLow;
+
+  float a = (sumMax - sumMin) / (2.0f * cycles);  // process amplitude, 0.1 °C
+  float d = (outHigh - outLow) / 2.0f;            // relay amplitude
+  float eps = hysteresis;
+  float root = a * a - eps * eps;
+  if (root <= 0) {
+    failed = true; // oscillation not above the hysteresis (noise only)
+    return;
+  }
+  ku = 4.0f * d / (PI * sqrt(root));
+  tu = sumPeriod / (1000.0f * cycles);
+  done = true;
+}
+
+float PIDAutoTune::getKp(Rule rule) const {
+  switch (rule) {
+    case RULE_CLASSIC: return 0.6f * ku;
+    case RULE_NO_OVERSHOOT: return 0.2f * ku;
+    default: return 0.45f * ku;
+  }
+}
+
+// Ki = Kp / Ti
+float PIDAutoTune::getKi(Rule rule) const {
+  if (tu <= 0) {
+    return 0;
+  }
+  switch (rule) {
+    case RULE_CLASSIC: return 0.6f * ku / (0.5f * tu);
+    case RULE_NO_OVERSHOOT: return 0.2f * ku / (0.5f * tu);
+    default: return 0.45f * ku / (tu / 1.2f);
+  }
+}
+
+// Kd = Kp * Td
+float PIDAutoTune::getKd(Rule rule) const {
+  switch (rule) {
+    case RULE_CLASSIC: return 0.6f * ku * tu / 8.0f;
+    case RULE_NO_OVERSHOOT: return 0.2f * ku * tu / 3.0f;
+    default: return 0;
+  }
+}
+
+bool PIDAutoTune::apply(PIDController& pid, Rule rule) const {
+  if (!done) {
+    return false;
+  }
+  pid.setTunings(getKp(rule), getKi(rule), getKd(rule));
+  pid.setDirection(direction);
+  return true;
+}
@@ -0,0 +1,126 @@
+#ifndef PID_AUTOTUNE_H
+#define PID_AUTOTUNE_H
+
+#include <Arduino.h>
+#include "PIDController.h"
+
+#define PID_AUTOTUNE_MAX_CYCLES 8
+
+/**
+ * PIDAutoTune
+ * Åström–Hägglund relay experiment: the output is switched between two
+ * levels around the setpoint (like a thermostat with hysteresis), which
+ * makes the process oscillate. From the amplitude a and period Tu of the
+ * oscillation and the relay amplitude d follow the ultimate gain
+ * Ku = 4d / (π·sqrt(a² - ε²)) (ε = hysteresis) and Tu, and from those
+ * the PID gains.
+ *
+ * The first cycle is skipped (start-up transient); the result averages the
+ * following ones. While running, call update() with every new sample and
+ * drive the process with getOutput().
+ *
+ * Usage:
+ *   PIDAutoTune tune(300, 0, 1000, 3);  // 30.0 °C, output 0/1000, ±0.3 °C
+ *   tune.start();
+ *   ...
+ *   if (sensor.read() && tune.update(sensor.getTemperatureDeci())) {
+ *     heaters.setDuty(id, tune.getOutput() / 10.0);
+ *   } else if (tune.isDone()) {
+ *     tune.apply(pid);
+ *   }
+ */
+class PIDAutoTune {
+  public:
+    enum Rule {
+      RULE_CLASSIC,       // Ziegler-Nichols PID: fast, some overshoot
+      RULE_NO_OVERSHOOT,  // Ziegler-Nichols "no overshoot" PID
+      RULE_PI             // Ziegler-Nichols PI: no D on the noisy DHT steps (default)
+    };
+
+  private:
+    int16_t setpoint;       // 0.1 °C
+    int16_t outLow, outHigh;
+    uint8_t hysteresis;     // 0.1 °C
+    uint8_t cycles;         // cycles to average
+    PIDController::Direction direction;
+    unsigned long timeout;  // ms
+    bool running, done, failed;
+    bool cycling;           // first switch to high has happened
+    bool high;              // output currently high
+    int16_t output;
+    int16_t peakMax, peakMin;        // extremes of the current half-cycles
+    int32_t sumMax, sumMin;          // over the measured cycles
+    uint8_t count;                   // completed cycles (incl. the skipped one)
+    unsigned long startTime;
+    unsigned long cycleStart;        // last switch to high
+    unsigned long sumPeriod;
+    float ku, tu;                    // result
+
+    void finish();
+
+  public:
+    /**
+     * Constructor
+     * @param setpointDeci Temperature to oscillate around, 0.1 °C
+     * @param outputLow Output while above the setpoint (heater)
+     * @param outputHigh Output while below the setpoint (heater)
+     * @param hysteresisDeci Switching band ± around the setpoint, 0.1 °C
+     *                       (above the sensor noise, e.g. 3 for a DHT22)
+     * @param cycles Oscillation cycles to average (1-8)
+     * @param dir DIRECT (heater) or REVERSE (fan: high output above setpoint)
+     */
+    PIDAutoTune(int16_t setpointDeci, int16_t outputLow, int16_t outputHigh,
+                uint8_t hysteresisDeci = 3, uint8_t cycles = 3,
+                PIDController::Direction dir = PIDController::DIRECT);
+
+    /**
+     * Start the experiment
+     * @param timeoutMs Give up after this time (default 2 h)
+     */
+    void start(unsigned long timeoutMs = 7200000UL);
+
+    /**
+     * Abort the experiment
+     */
+    void cancel();
+
+    /**
+     * Feed a new sample and switch the output
+     * @param input Measurement in 0.1 °C
+     * @param nowMs millis() of the sample
+     * @return true while the experiment runs (use getOutput())
+     */
+    bool update(int16_t input, unsigned long nowMs);
+    bool update(int16_t input) { return update(input, millis()); }
+
+    bool isRunning() const { return running; }
+    bool isDone() const { return done; }
+    bool isFailed() const { return failed; }
+
+    /**
+     * Output to apply while running
+     */
+    int16_t getOutput() const { return output; }
+
+    /**
+     * Results (valid once isDone())
+     * @return Ultimate gain (output per 0.1 °C) and period (s)
+     */
+    float getUltimateGain() const { return ku; }
+    float getUltimatePeriod() const { return tu; }
+
+    /**
+     * Gains for PIDController from the chosen rule
+     */
+    float getKp(Rule rule = RULE_PI) const;
+    float getKi(Rule rule = RULE_PI) const;
+    float getKd(Rule rule = RULE_PI) const;
+
+    /**
+     * Set the gains of a controller
+     * @return false if the experiment has not finished
+     */
+    bool apply(PIDController& pid, Rule rule = RULE_PI) const;
+};
+
+#endif // PID_AUTOTUNE_H
@@ -0,0 +1,133 @@
+#include "PIDController.h"
+
+#define PID_INPUT_INVALID INT16_MIN  // same as DHT_INVALID_DECI
+
+PIDController::PIDController(float p, float i, float d, unsigned long sample, Direction dir)
+: setpoint(0), lastInput(0), output(0), outMin(0), outMax(1000), integral(0),
+  derivative(0), dFilter(2), sampleMs(sample ? sample : 1), lastTime(0), direction(dir), automatic(true), initialized(false) {
+  setTunings(p, i, d);
+}
+
+int32_t PIDController::toFixed(float value) {
+  float q = value * 65536.0f;
+  q = constrain(q, -2147483000.0f, 2147483000.0f);
+  return (int32_t)(q < 0 ? q - 0.5f : q + 0.5f);
+}
+
+// Fold the sample time into Ki and Kd once, so compute() is integer only
+void PIDController::scaleGains() {
+  float seconds = sampleMs / 1000.0f;
+  kp = toFixed(kpSet);
+  ki = toFixed(kiSet * seconds);
+  kd = toFixed(kdSet / seconds);
+}
+
+void PIDController::setTunings(float p, float i, float d) {
+  if (p < 0 || i < 0 || d < 0) {
+    return; // use setDirection() for a reverse-acting process
+  }
+  kpSet = p;
+  kiSet = i;
+  kdSet = d;
+  scaleGains();
+}
+
+void PIDController::setSampleTime(unsigned long ms) {
+  if (ms > 0) {
+    sampleMs = ms;
+    scaleGains();
+  }
+}
+
+void PIDController::setSetpoint(int16_t deci) {
+  setpoint = deci;
+}
+
+void PIDController::setOutputLimits(int16_t min, int16_t max) {
+  if (min >= max) {
+    return;
+  }
+  outMin = min;
+  outMax = max;
+  output = constrain(output, outMin, outMax);
+  integral = constrain(integral, (int32_t)outMin * 65536, (int32_t)outMax * 65536);
+}
+
+void PIDController::setDirection(Direction dir) {
+  direction = dir;
+}
+
+void PIDController::setDerivativeFilter(uint8_t shift) {
+  dFilter = min(shift, (uint8_t)8);
+}
+
+void PIDController::setAutomatic(bool on) {
+  if (on && !automatic) {
+    initialized = false; // bumpless: restart from the manual output
+  }
+  automatic = on;
+}
+
+void PIDController::setOutput(int16_t value) {
+  if (!automatic) {
+    output = constrain(value, outMin, outMax);
+  }
+}
+
+void PIDController::reset() {
+  initialized = false;
+  output = outMin; // compute() restarts the integral from the output
+  integral = 0;
+  derivative = 0;
+}
+
+bool PIDController::compute(int16_t input, unsigned long nowMs) {
+  if (!automatic || input == PID_INPUT_INVALID) {
+    return false;
+  }
+  if (!initialized) {
+    // Start from the current output with no derivative history
+    lastInput = input;
+    integral = (int32_t)output * 65536;
+    derivative = 0;
+    lastTime = nowMs - sampleMs;
+    initialized = true;
+  }
+  if (nowMs - lastTime < sampleMs) {
+    return false;
+  }
+  lastTime = nowMs;
+
+  int32_t error = (int32_t)setpoint - input;
+  int32_t delta = (int32_t)input - lastInput;
+  if (direction == REVERSE) {
+    error = -error;
+    delta = -delta;
+  }
+  lastInput = input;
+
+  const int64_t lo = (int64_t)outMin * 65536;
+  const int64_t hi = (int64_t)outMax * 65536;
+  derivative += (-(int64_t)kd * delta - derivative) / (1 << dFilter);
+  int64_t pd = (int64_t)kp * error + derivative;
+
+  // Anti-windup: the integral may only fill the headroom that P and D
+  // leave in the output range (and stays within the range itself), so it
+  // does not build up while the output is saturated during a long approach
+  int64_t i = integral + (int64_t)ki * error;
+  if (pd + i > hi) {
+    i = max(hi - pd, min(i, (int64_t)integral));
+  } else if (pd + i < lo) {
+    i = min(lo - pd, max(i, (int64_t)integral));
+  }
+  i = constrain(i, lo, hi);
+  integral = (int32_t)i;
+
+  int64_t sum = constrain(pd + i, lo, hi);
+  output = (int16_t)((sum + 0x8000) >> 16); // round, Q16.16 -> integer
+  return true;
+}
+
+float PIDController::getOutputPercent() const {
+  return (output - outMin) * 100.0f / (outMax - outMin);
+}
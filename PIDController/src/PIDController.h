@@ -0,0 +1,144 @@
+#ifndef PID_CONTROLLER_H
+#define PID_CONTROLLER_H
+
+#include <Arduino.h>
+
+/**
+ * PIDController
+ * PID controller for slow loops such as a heater or fan on a DHT sensor,
+ * computed in fixed point (no floating point per step, fine on AVR).
+ *
+ * - Input and setpoint in tenths (0.1 °C), as from getTemperatureDeci()
+ * - Output in a configurable integer range, default 0-1000 (0.1 %), for
+ *   RelayPWM::setDuty(), analogWrite() or a DAC
+ * - Gains are given as float once and kept as Q16.16 integers, already
+ *   scaled by the sample time
+ * - Derivative on measurement: a setpoint change gives no output kick;
+ *   low-pass filtered, since the DHT's 0.1 °C steps are noisy
+ * - Anti-windup: the integral is clamped to the headroom P and D leave in
+ *   the output range (and to the range itself), so it cannot grow while
+ *   the output is saturated and shrinks when P and D take up more of it
+ * - Bumpless: switching from manual to automatic starts from the current
+ *   output
+ *
+ * Gain units: Kp = output per 0.1 °C of error, Ki = output per 0.1 °C per
+ * second, Kd = output per 0.1 °C/s. PIDAutoTune finds them for you.
+ *
+ * Usage:
+ *   PIDController pid(2.0, 0.05, 10.0, 2000);   // Kp, Ki, Kd, sample ms
+ *   pid.setSetpoint(300);                       // 30.0 °C
+ *   if (sensor.read() && pid.compute(sensor.getTemperatureDeci())) {
+ *     heaters.setDuty(id, pid.getOutputPercent());
+ *   }
+ */
+class PIDController {
+  public:
+    enum Direction {
+      DIRECT = 0,  // output raises the input (heater)
+      REVERSE      // output lowers the input (fan, cooler)
+    };
+
+  private:
+    int32_t kp, ki, kd;       // Q16.16, ki and kd scaled by the sample time
+    float kpSet, kiSet, kdSet; // as given, for the getters
+    int16_t setpoint;         // 0.1 °C
+    int16_t lastInput;
+    int16_t output;
+    int16_t outMin, outMax;
+    int32_t integral;         // Q16.16 output units
+    int64_t derivative;       // filtered D term, Q16.16 output units
+    uint8_t dFilter;          // D low-pass, alpha = 1 / 2^dFilter
+    unsigned long sampleMs;
+    unsigned long lastTime;
+    Direction direction;
+    bool automatic;
+    bool initialized;         // lastInput and integral are set
+
+    static int32_t toFixed(float value);
+    void scaleGains();
+
+  public:
+    /**
+     * Constructor
+     * @param kp Proportional gain (output per 0.1 °C)
+     * @param ki Integral gain (output per 0.1 °C·s)
+     * @param kd Derivative gain (output per 0.1 °C/s)
+     * @param sampleMs Time between computations (2000 for a DHT)
+     * @param dir DIRECT (heater) or REVERSE (fan)
+     */
+    PIDController(float kp, float ki, float kd, unsigned long sampleMs = 2000, Direction dir = DIRECT);
+
+    /**
+     * Compute a new output if the sample time has passed
+     * @param input Measurement in 0.1 °C (DHT_INVALID_DECI / INT16_MIN is ignored)
+     * @param nowMs millis()
+     * @return true if the output was updated
+     */
+    bool compute(int16_t input, unsigned long nowMs);
+    bool compute(int16_t input) { return compute(input, millis()); }
+
+    /**
+     * Set the target in 0.1 °C
+     */
+    void setSetpoint(int16_t deci);
+    int16_t getSetpoint() const { return setpoint; }
+
+    /**
+     * Set the gains (see class comment for units)
+     */
+    void setTunings(float kp, float ki, float kd);
+    float getKp() const { return kpSet; }
+    float getKi() const { return kiSet; }
+    float getKd() const { return kdSet; }
+
+    /**
+     * Set the time between computations (rescales Ki and Kd)
+     */
+    void setSampleTime(unsigned long ms);
+
+    /**
+     * Set the output range (default 0-1000)
+     */
+    void setOutputLimits(int16_t min, int16_t max);
+
+    void setDirection(Direction dir);
+
+    /**
+     * Low-pass filter on the derivative term
+     * @param shift alpha = 1 / 2^shift (0 = off, default 2 = 1/4)
+     */
+    void setDerivativeFilter(uint8_t shift);
+
+    /**
+     * Switch between automatic (compute() sets the output) and manual
+     * (setOutput() sets it). Back in automatic the controller continues
+     * from the manual output without a bump.
+     */
+    void setAutomatic(bool on);
+    bool isAutomatic() const { return automatic; }
+
+    /**
+     * Set the output in manual mode
+     */
+    void setOutput(int16_t value);
+
+    /**
+     * Forget the integral and the last input; the output restarts from the
+     * minimum (setAutomatic() is the bumpless restart)
+     */
+    void reset();
+
+    /**
+     * Current output
+     * @return Value in the output range
+     */
+    int16_t getOutput() const { return output; }
+
+    /**
+     * Output as a percentage of the output range, for RelayPWM::setDuty()
+     * @return 0-100 %
+     */
+    float getOutputPercent() const;
+};
+
+#endif // PID_CONTROLLER_H
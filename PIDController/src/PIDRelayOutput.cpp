@@ -0,0 +1,27 @@
+#include "PIDRelayOutput.h"
+
+PIDRelayOutput::PIDRelayOutput(int16_t on, int16_t off)
+: onLevel(600), offLevel(400), state(false) {
+  setLevels(on, off);
+}
+
+void PIDRelayOutput::setLevels(int16_t on, int16_t off) {
+  if (off >= on) {
+    return;
+  }
+  onLevel = on;
+  offLevel = off;
+}
+
+bool PIDRelayOutput::update(int16_t output) {
+  if (!state && output >= onLevel) {
+    state = true;
+  } else if (state && output <= offLevel) {
+    state = false;
+  }
+  return state;
+}
+
+void PIDRelayOutput::reset(bool on) {
+  state = on;
+}
@@ -0,0 +1,72 @@
+#ifndef PID_RELAY_OUTPUT_H
+#define PID_RELAY_OUTPUT_H
+
+#include <Arduino.h>
+#include "PIDController.h"
+
+/**
+ * PIDRelayOutput
+ * Deadband output stage for driving a relay directly from a PIDController
+ * instead of a time-proportional window: the relay switches ON when the
+ * output rises to the upper level and OFF when it falls to the lower one.
+ *
+ * This is a thermostat whose switching band moves with the PID output:
+ * the integral shifts the band until the average temperature sits on the
+ * setpoint, and P (and D) move the switch points ahead of the temperature
+ * swing. Each relay cycle is one ON and one OFF, so the number of switches
+ * is set by the band width, not by a window length.
+ *
+ * Compared with a fixed ±1 °C hysteresis, an oversized heater (3-5x the
+ * holding power) gets about 0.4-0.5 °C less overshoot, 7-17 % fewer
+ * switches and a mean within 0.4 °C of the setpoint instead of 0.6-1.9 °C
+ * above it. With a heater at about 50 % duty at the setpoint, bang-bang is
+ * already symmetric and the two are on par. See the README and
+ * extras/test/PID_SimulatedPlant_test.cpp.
+ *
+ * Usage:
+ *   PIDRelayOutput stage(600, 400);            // for the default 0-1000
+ *   if (sensor.read() && pid.compute(sensor.getTemperatureDeci())) {
+ *     heater.setState(stage.update(pid));
+ *   }
+ */
+class PIDRelayOutput {
+  private:
+    int16_t onLevel;
+    int16_t offLevel;
+    bool state;
+
+  public:
+    /**
+     * Constructor
+     * @param onLevel Output at or above which the relay switches ON
+     * @param offLevel Output at or below which it switches OFF (below onLevel)
+     */
+    PIDRelayOutput(int16_t onLevel = 600, int16_t offLevel = 400);
+
+    /**
+     * Change the switching levels (ignored unless offLevel < onLevel)
+     */
+    void setLevels(int16_t onLevel, int16_t offLevel);
+    int16_t getOnLevel() const { return onLevel; }
+    int16_t getOffLevel() const { return offLevel; }
+
+    /**
+     * Apply a new controller output (call after each compute())
+     * @param output Controller output
+     * @return Relay state
+     */
+    bool update(int16_t output);
+    bool update(const PIDController& pid) { return update(pid.getOutput()); }
+
+    /**
+     * Current relay state
+     */
+    bool isOn() const { return state; }
+
+    /**
+     * Set the relay state, e.g. after a manual override
+     */
+    void reset(bool on = false);
+};
+
+#endif // PID_RELAY_OUTPUT_H
@@ -0,0 +1,57 @@
+/*
+ * RelayBankInterlock
+ *
+ * Climate controller with fan, heater, cooler and pump on a
+ * 74HC595-driven relay board. Every mode change is applied as one
+ * state vector (one latch pulse), and heater/cooler are interlocked
+ * so they can never be ON together.
+ *
+ * Send '0'..'3' over Serial to select a mode.
+ *
+ * Hardware:
+ * - 74HC595: SER → GPIO23, SRCLK → GPIO18, RCLK → GPIO5
+ * - Relay board inputs on QA..QD (active-low board)
+ */
+
+#include <RelayBank.h>
+
+const uint8_t FAN = 0;
+const uint8_t HEATER = 1;
+const uint8_t COOLER = 2;
+const uint8_t PUMP = 3;
+
+#define BIT(r) (1UL << (r))
+
+RelayBank bank(23, 18, 5, 8, true);
+
+const uint32_t MODES[] = {
+  0,                                  // 0: all off
+  BIT(FAN),                           // 1: ventilate
+  BIT(FAN) | BIT(HEATER),             // 2: heat
+  BIT(FAN) | BIT(COOLER) | BIT(PUMP)  // 3: cool
+};
+
+void setup() {
+  Serial.begin(115200);
+  bank.begin();
+  bank.addInterlock(BIT(HEATER) | BIT(COOLER));
+  Serial.println("Send 0-3 to select mode");
+}
+
+void loop() {
+  if (Serial.available()) {
+    char c = Serial.read();
+    if (c >= '0' && c <= '3') {
+      bank.apply(MODES[c - '0']);
+      Serial.print("Mode ");
+      Serial.print(c);
+      Serial.print(" -> state 0x");
+      Serial.println(bank.getState(), HEX);
+    } else if (c == 'x') {
+      // Illegal on purpose: heater and cooler together
+      if (!bank.apply(BIT(HEATER) | BIT(COOLER))) {
+        Serial.println("Rejected: heater/cooler interlock");
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ * RelayCycleLog
+ *
+ * Counts switch operations and ON time of two relays and keeps them
+ * across reboots. The counters are written at most once per minute
+ * (use the 15 min default in real installations).
+ *
+ * Send 'a' / 'b' over Serial to toggle a relay, 's' for statistics,
+ * 'f' to write the log now.
+ *
+ * Hardware:
+ * - Relay modules on GPIO 26 and 27 (ESP32) or pins 7 and 8 (AVR)
+ */
+
+#include <RelayController.h>
+#include <RelayLog.h>
+
+#if defined(ESP32)
+RelayController relayA(26);
+RelayController relayB(27);
+RelayLogFlash storage("/relaylog.bin", 4096);
+#else
+RelayController relayA(7);
+RelayController relayB(8);
+RelayLogEEPROM storage(0, 512);
+#endif
+
+RelayLog relayLog(storage, 60000UL);
+
+// Typical rated mechanical life of a hobby relay module
+const uint32_t RATED_OPERATIONS = 100000UL;
+
+void printRelay(const char* name, RelayController& relay) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(relay.getSwitchCount());
+  Serial.print(" operations (");
+  Serial.print(relay.getSwitchCount() * 100.0 / RATED_OPERATIONS, 2);
+  Serial.print("% of rated life), ON for ");
+  Serial.print(relay.getOnTime() / 3600.0, 2);
+  Serial.println(" h");
+}
+
+void setup() {
+  Serial.begin(115200);
+  relayA.begin();
+  relayB.begin();
+
+  relayLog.attach(relayA);
+  relayLog.attach(relayB);
+  if (relayLog.begin()) {
+    Serial.println("Counters restored");
+  } else {
+    Serial.println("Empty log, starting from zero");
+  }
+  Serial.print("Log slots: ");
+  Serial.println(relayLog.getSlotCount());
+}
+
+void loop() {
+  relayLog.update();
+
+  if (Serial.available()) {
+    switch (Serial.read()) {
+      case 'a': relayA.toggle(); break;
+      case 'b': relayB.toggle(); break;
+      case 'f':
+        relayLog.flush();
+        Serial.println("Log written");
+        break;
+      case 's':
+        printRelay("Relay A", relayA);
+        printRelay("Relay B", relayB);
+        Serial.print("Records written since boot: ");
+        Serial.println(relayLog.getWriteCount());
+        break;
+    }
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * RelayStaggeredStart
+ *
+ * Three loads are requested ON in the same instant. RelayScheduler
+ * releases them 1 s apart so their inrush currents never add up, and
+ * keeps the compressor from short-cycling when the thermostat flaps.
+ *
+ * Send '1' / '0' over Serial to request all loads ON / OFF.
+ *
+ * Hardware:
+ * - Relay modules on GPIO 26 (compressor), 27 (fan), 25 (pump)
+ */
+
+#include <RelayController.h>
+#include <RelayScheduler.h>
+
+RelayController compressor(26);
+RelayController fan(27);
+RelayController pump(25);
+
+RelayScheduler scheduler(1000);  // 1 s between switch-ONs
+
+int8_t compId, fanId, pumpId;
+
+void report(const char* name, int8_t id) {
+  Serial.print(name);
+  if (scheduler.isPending(id)) {
+    Serial.print(" in ");
+    Serial.print((scheduler.effectiveAt(id) - millis()) / 1000);
+    Serial.println(" s");
+  } else {
+    Serial.println(" now");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  compressor.begin();
+  fan.begin();
+  pump.begin();
+
+  // Compressor: min 2 min ON, min 5 min OFF, max 6 starts per hour
+  compId = scheduler.add(compressor, 120000UL, 300000UL, 6);
+  fanId = scheduler.add(fan);
+  pumpId = scheduler.add(pump);
+
+  Serial.println("Send 1 = all ON, 0 = all OFF");
+}
+
+void loop() {
+  scheduler.update();
+
+  if (Serial.available()) {
+    char c = Serial.read();
+    if (c == '1' || c == '0') {
+      bool on = (c == '1');
+      scheduler.request(compId, on);
+      scheduler.request(fanId, on);
+      scheduler.request(pumpId, on);
+      report("Compressor", compId);
+      report("Fan", fanId);
+      report("Pump", pumpId);
+    }
+  }
+}
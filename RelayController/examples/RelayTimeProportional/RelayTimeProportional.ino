@@ -0,0 +1,69 @@
+/*
+ * RelayTimeProportional
+ *
+ * Proportional heater control with relays instead of on/off hysteresis.
+ * A simple P controller turns the temperature error into a duty, which
+ * RelayPWM converts to ON time in a 10 second window. Two heaters are
+ * interleaved so they never draw power at the same time while the total
+ * duty stays below 100 %.
+ *
+ * Temperature is simulated; replace readTemperature() with your sensor.
+ *
+ * Hardware:
+ * - Relay modules (or SSRs) on GPIO 26 and 27
+ */
+
+#include <RelayController.h>
+#include <RelayPWM.h>
+
+const float SETPOINT = 60.0;  // °C
+const float GAIN = 20.0;      // % duty per °C of error
+
+RelayController heater1(26);
+RelayController heater2(27);
+RelayPWM heaters(10000, 500);  // 10 s window, 0.5 s minimum pulse
+
+int8_t h1, h2;
+float temperature = 20.0;
+
+float readTemperature() {
+  // Crude thermal model: heating from the duty, losses to 20 °C ambient
+  float power = (heaters.getDuty(h1) + heaters.getDuty(h2)) / 100.0;
+  temperature += power * 0.08 - (temperature - 20.0) * 0.002;
+  return temperature;
+}
+
+void setup() {
+  Serial.begin(115200);
+  heater1.begin();
+  heater2.begin();
+
+  h1 = heaters.add(heater1);
+  h2 = heaters.add(heater2);
+  heaters.begin();
+}
+
+void loop() {
+  static unsigned long lastControl = 0;
+
+  heaters.update();
+
+  if (millis() - lastControl >= 1000) {
+    lastControl = millis();
+
+    float t = readTemperature();
+    float duty = constrain((SETPOINT - t) * GAIN, 0.0, 200.0);
+
+    // Split the demand over both heaters, 100 % each
+    heaters.setDuty(h1, min(duty, 100.0f));
+    heaters.setDuty(h2, max(duty - 100.0f, 0.0f));
+
+    Serial.print("T=");
+    Serial.print(t, 1);
+    Serial.print(" C  duty=");
+    Serial.print(duty, 0);
+    Serial.print("%  next switch in ");
+    Serial.print(heaters.msToNextEdge());
+    Serial.println(" ms");
+  }
+}
@@ -0,0 +1,62 @@
+/*
+ * RelayZeroCross
+ *
+ * Switches an AC lamp at the mains zero crossing to avoid contact arcing.
+ * The relay coil is driven early by its operate delay so the contact
+ * closes right at the crossing.
+ *
+ * Send '1' / '0' over Serial to switch the lamp.
+ *
+ * Hardware:
+ * - Zero-cross detector module (e.g. H11AA1 based), ZC output on GPIO 27
+ *   (ESP32) or pin 2 (UNO, INT0)
+ * - Relay module on GPIO 26 (ESP32) or pin 7 (UNO)
+ *
+ * WARNING: mains voltage. Use an isolated detector module and keep the
+ * low-voltage side separated from the AC wiring.
+ */
+
+#include <RelayController.h>
+#include <ZeroCrossSync.h>
+#include <ZeroCrossSyncTimer1.h>  // AVR: drive the coil from Timer1 (opt-in)
+
+#if defined(ESP32)
+const uint8_t ZC_PIN = 27;
+RelayController lamp(26);
+#else
+const uint8_t ZC_PIN = 2;
+RelayController lamp(7);
+#endif
+
+ZeroCrossSync zeroCross;
+int8_t lampId;
+
+void setup() {
+  Serial.begin(115200);
+  lamp.begin();
+
+  zeroCross.begin(ZC_PIN, RISING);
+  // Typical small signal relay: 8 ms operate, 4 ms release (measure yours)
+  lampId = zeroCross.attach(lamp, 8000, 4000);
+
+  Serial.println("Waiting for mains lock...");
+  while (!zeroCross.isLocked()) {
+    delay(10);
+  }
+  Serial.print("Locked, mains ");
+  Serial.print(zeroCross.getFrequency(), 2);
+  Serial.println(" Hz");
+}
+
+void loop() {
+  zeroCross.update();  // only needed on boards without a timer backend
+
+  if (Serial.available()) {
+    char c = Serial.read();
+    if (c == '1' || c == '0') {
+      bool synced = zeroCross.setState(lampId, c == '1');
+      Serial.println(synced ? "Switching at next zero crossing"
+                            : "No mains lock, switched immediately");
+    }
+  }
+}
@@ -0,0 +1,27 @@
+// Minimal Arduino API for building the library sources on a host (tests only).
+// Time is driven by the test through hostMicros.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define FALLING 2
+#define RISING 3
+
+extern uint32_t hostMicros;
+extern uint8_t hostPins[64];
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline unsigned long micros() { return hostMicros; }
+inline unsigned long millis() { return hostMicros / 1000; }
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t level) { hostPins[pin & 63] = level; }
+inline int digitalRead(uint8_t pin) { return hostPins[pin & 63]; }
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Host simulation of RelayPWM with interleaved channels: every completed ON
+ * pulse must be at least the minimum pulse, in the first window after
+ * begin(), in steady state, and after duty changes that move the offsets
+ * (where the ON time wrapping past the window end used to leave a short
+ * standalone pulse at the window start).
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../../src -I../../../GPIOShadow/src
+ *     RelayPWM_test.cpp ../../src/RelayPWM.cpp ../../src/RelayController.cpp
+ *     ../../../GPIOShadow/src/GPIOShadow.cpp -o pwm_test && ./pwm_test
+ */
+
+#include <stdio.h>
+#include "RelayPWM.h"
+
+uint32_t hostMicros = 0;
+uint8_t hostPins[64];
+
+#define PWM_TEST_WINDOW 10000UL
+#define PWM_TEST_MIN_PULSE 2000UL
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double value) {
+  if (!ok) {
+    printf("FAIL: %s (%.0f)\n", what, value);
+    failures++;
+  }
+}
+
+struct Tracker {
+  bool on;
+  unsigned long since;
+  unsigned long shortest;
+  unsigned pulses;
+};
+
+// Run for `ms` milliseconds, calling update() every millisecond
+static void run(RelayPWM& pwm, RelayController* relays, Tracker* tr, uint8_t n,
+                unsigned long ms, const char* phase) {
+  for (unsigned long i = 0; i < ms; i++) {
+    hostMicros += 1000;
+    pwm.update();
+    unsigned long now = hostMicros / 1000;
+    for (uint8_t k = 0; k < n; k++) {
+      bool on = relays[k].isOn();
+      if (on == tr[k].on) {
+        continue;
+      }
+      if (!on) {
+        unsigned long len = now - tr[k].since;
+        tr[k].pulses++;
+        if (len < tr[k].shortest) {
+          tr[k].shortest = len;
+        }
+        if (len < PWM_TEST_MIN_PULSE) {
+          printf("  %s: channel %d ON for %lu ms at %lu ms\n", phase, k, len, now);
+        }
+        check(len >= PWM_TEST_MIN_PULSE, "ON pulse shorter than the minimum", len);
+      }
+      tr[k].on = on;
+      tr[k].since = now;
+    }
+  }
+}
+
+int main() {
+  RelayController relays[3] = { RelayController(5), RelayController(6), RelayController(7) };
+  RelayPWM pwm(PWM_TEST_WINDOW, PWM_TEST_MIN_PULSE);
+  Tracker tr[3];
+  for (uint8_t k = 0; k < 3; k++) {
+    relays[k].begin();
+    pwm.add(relays[k]);
+    tr[k].on = false;
+    tr[k].since = 0;
+    tr[k].shortest = ~0UL;
+    tr[k].pulses = 0;
+  }
+
+  // 50 % + 60 %: the second ON time wraps 1 s past the window end
+  pwm.setDuty(0, 50);
+  pwm.setDuty(1, 60);
+  pwm.begin();
+  run(pwm, relays, tr, 3, 5 * PWM_TEST_WINDOW, "first windows");
+
+  // No wrap: the second channel ends OFF at the window end ...
+  pwm.setDuty(0, 30);
+  run(pwm, relays, tr, 3, 5 * PWM_TEST_WINDOW, "no wrap");
+
+  // ... then the offsets move and it wraps 1 s into a window start where it
+  // was OFF: that part must not become a 1 s pulse
+  pwm.setDuty(0, 50);
+  run(pwm, relays, tr, 3, 5 * PWM_TEST_WINDOW, "duty change");
+
+  pwm.setDuty(0, 80);
+  pwm.setDuty(1, 40);
+  pwm.setDuty(2, 45);
+  run(pwm, relays, tr, 3, 5 * PWM_TEST_WINDOW, "third channel");
+
+  for (uint8_t k = 0; k < 3; k++) {
+    printf("channel %d: %u pulses, shortest %lu ms\n", k, tr[k].pulses, tr[k].shortest);
+    check(tr[k].pulses >= 4, "too few pulses", tr[k].pulses);
+  }
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Host simulation of ZeroCrossSync with a 50 Hz and a 60 Hz mains signal.
+ * Every synchronised switch must move the contact within ZC_TEST_TOLERANCE_US
+ * of a true zero crossing, despite detector jitter and glitch edges.
+ *
+ * Build and run from this directory:
+ *   g++ -std=gnu++11 -Wall -I. -I../../src -I../../../GPIOShadow/src
+ *     ZeroCrossSync_test.cpp ../../src/ZeroCrossSync.cpp
+ *     ../../src/RelayController.cpp ../../../GPIOShadow/src/GPIOShadow.cpp
+ *     -o zc_test && ./zc_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ZeroCrossSync.h"
+
+uint32_t hostMicros = 0;
+uint8_t hostPins[64];
+
+#define ZC_TEST_TOLERANCE_US 150  // detector jitter is +-60 us
+#define ZC_TEST_OPERATE_US 8000
+#define ZC_TEST_RELEASE_US 4000
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double value) {
+  if (!ok) {
+    printf("FAIL: %s (%.1f)\n", what, value);
+    failures++;
+  }
+}
+
+// Crossings at start + n * half period; detector edges carry +-60 us jitter
+// and every 37th half wave a glitch edge 2 ms after the crossing.
+static void simulate(double hz, uint32_t start) {
+  double half = 500000.0 / hz;
+  RelayController relay(5);
+  relay.begin();
+  ZeroCrossSync zc;
+  zc.begin(2);
+  int8_t id = zc.attach(relay, ZC_TEST_OPERATE_US, ZC_TEST_RELEASE_US);
+
+  srand(1);
+  int switches = 0;
+  double worst = 0;
+  bool want = false;
+  uint32_t requestAt = start + 300000;  // after the loop has had time to lock
+
+  for (uint32_t n = 0; n < 200; n++) {
+    uint32_t crossing = start + (uint32_t)(n * half + 0.5);
+    uint32_t edge = crossing + (rand() % 121) - 60;
+    uint32_t glitch = (n % 37 == 36) ? crossing + 2000 : 0;
+
+    // Run timer expiries and switch requests up to the next detector edge
+    for (;;) {
+      uint32_t alarm;
+      bool armed = zc.nextAlarm(alarm);
+      if (armed && (int32_t)(alarm - edge) < 0 && (int32_t)(alarm - requestAt) <= 0) {
+        hostMicros = alarm;
+        bool before = relay.isOn();
+        zc.handleTimer(alarm);
+        if (relay.isOn() != before) {
+          // Contact moves one operate/release delay after the coil
+          uint32_t contact = alarm + (relay.isOn() ? ZC_TEST_OPERATE_US : ZC_TEST_RELEASE_US);
+          double k = (double)(int32_t)(contact - start) / half;
+          double err = ((double)(int32_t)(contact - start) - (long)(k + 0.5) * half);
+          if (err < 0) {
+            err = -err;
+          }
+          if (err > worst) {
+            worst = err;
+          }
+          check(err <= ZC_TEST_TOLERANCE_US, "contact off the zero crossing", err);
+          switches++;
+        }
+      } else if ((int32_t)(requestAt - edge) < 0) {
+        hostMicros = requestAt;
+        want = !want;
+        check(zc.setState(id, want), "switch not synchronised after lock", hostMicros - start);
+        requestAt += 47000 + rand() % 20000;
+      } else {
+        break;
+      }
+    }
+
+    hostMicros = edge;
+    zc.handleCrossing(edge);
+    if (glitch) {
+      hostMicros = glitch;
+      zc.handleCrossing(glitch);
+    }
+  }
+
+  double f = zc.getFrequency();
+  check(zc.isLocked(), "lock lost", 0);
+  check(f > hz - 0.2 && f < hz + 0.2, "frequency estimate", f);
+  check(switches >= 20, "too few switches", switches);
+  printf("%.0f Hz: %d switches, worst contact error %.0f us, %.2f Hz tracked\n",
+         hz, switches, worst, f);
+  zc.end();
+}
+
+int main() {
+  simulate(50.0, 1000);
+  simulate(60.0, 1000);
+  simulate(50.0, 0xFFFFF000UL);  // micros() rollover during the run
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
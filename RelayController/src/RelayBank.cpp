@@ -0,0 +1,237 @@
+#include "RelayBank.h"
+#include <GPIOShadow.h>
+
+#if defined(ESP32)
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#endif
+
+RelayBank::RelayBank(const uint8_t* relayPins, uint8_t relayCount, bool invertLogic)
+: shiftRegister(false), started(false), count(relayCount), dataPin(0), clockPin(0), latchPin(0),
+  state(0), activeLow(0), interlockCount(0) {
+  if (count > RELAY_BANK_MAX) {
+    count = RELAY_BANK_MAX;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    pins[i] = relayPins[i];
+    if (invertLogic) {
+      activeLow |= (1UL << i);
+    }
+  }
+}
+
+RelayBank::RelayBank(uint8_t data, uint8_t clock, uint8_t latch, uint8_t relayCount, bool invertLogic)
+: shiftRegister(true), started(false), count(relayCount), dataPin(data), clockPin(clock), latchPin(latch),
+  state(0), activeLow(0), interlockCount(0) {
+  if (count > RELAY_BANK_MAX) {
+    count = RELAY_BANK_MAX;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    pins[i] = 0;
+    if (invertLogic) {
+      activeLow |= (1UL << i);
+    }
+  }
+}
+
+void RelayBank::begin() {
+  if (shiftRegister) {
+    pinMode(dataPin, OUTPUT);
+    pinMode(clockPin, OUTPUT);
+    pinMode(latchPin, OUTPUT);
+    GPIOShadow::forget(dataPin);
+    GPIOShadow::forget(clockPin);
+    GPIOShadow::forget(latchPin);
+    GPIOShadow::write(latchPin, LOW);
+    GPIOShadow::write(clockPin, LOW);
+    writeShiftRegister(activeLow); // all relays OFF
+  } else {
+    for (uint8_t i = 0; i < count; i++) {
+      pinMode(pins[i], OUTPUT);
+      GPIOShadow::forget(pins[i]);
+      GPIOShadow::write(pins[i], (activeLow & (1UL << i)) ? HIGH : LOW); // OFF
+    }
+  }
+  state = 0;
+  started = true;
+}
+
+void RelayBank::setInverted(uint8_t index, bool invertLogic) {
+  if (index >= count) {
+    return;
+  }
+  uint32_t bit = 1UL << index;
+  uint32_t old = activeLow;
+  if (invertLogic) {
+    activeLow |= bit;
+  } else {
+    activeLow &= ~bit;
+  }
+  if (!started || activeLow == old) {
+    return;
+  }
+  // Same logical state, opposite physical level
+  if (shiftRegister) {
+    writeShiftRegister(state ^ activeLow);
+  } else {
+    writePins(state ^ activeLow, bit);
+  }
+}
+
+bool RelayBank::addInterlock(uint32_t mask) {
+  if (interlockCount >= RELAY_BANK_MAX_INTERLOCKS) {
+    return false;
+  }
+  interlocks[interlockCount++] = mask;
+  return true;
+}
+
+bool RelayBank::isAllowed(uint32_t newState) const {
+  for (uint8_t i = 0; i < interlockCount; i++) {
+    uint32_t active = newState & interlocks[i];
+    if (active & (active - 1)) {
+      return false; // more than one bit set
+    }
+  }
+  return true;
+}
+
+bool RelayBank::apply(uint32_t newState) {
+  if (count < 32) {
+    newState &= (1UL << count) - 1;
+  }
+  if (!isAllowed(newState)) {
+    return false;
+  }
+  if (newState != state) {
+    writeOutputs(newState);
+    state = newState;
+  }
+  return true;
+}
+
+bool RelayBank::set(uint8_t index, bool on) {
+  if (index >= count) {
+    return false;
+  }
+  uint32_t newState = on ? (state | (1UL << index)) : (state & ~(1UL << index));
+  return apply(newState);
+}
+
+void RelayBank::allOff() {
+  apply(0);
+}
+
+uint32_t RelayBank::getState() const {
+  return state;
+}
+
+bool RelayBank::isOn(uint8_t index) const {
+  return index < count && (state & (1UL << index));
+}
+
+uint8_t RelayBank::size() const {
+  return count;
+}
+
+void RelayBank::writeOutputs(uint32_t newState) {
+  // Output levels: bit i = pin/output HIGH
+  uint32_t levels = newState ^ activeLow;
+  if (shiftRegister) {
+    writeShiftRegister(levels);
+  } else {
+    writePins(levels, newState ^ state);
+  }
+}
+
+void RelayBank::writeShiftRegister(uint32_t levels) {
+  // Last byte shifted lands in the first chip, so send the highest byte first
+  uint8_t chips = (count + 7) / 8;
+  for (int8_t b = chips - 1; b >= 0; b--) {
+    shiftOut(dataPin, clockPin, MSBFIRST, (uint8_t)(levels >> (8 * b)));
+  }
+  GPIOShadow::forget(dataPin);
+  GPIOShadow::forget(clockPin);
+
+  // All outputs change together on the latch edge
+  GPIOShadow::write(latchPin, HIGH);
+  GPIOShadow::write(latchPin, LOW);
+}
+
+void RelayBank::writePins(uint32_t levels, uint32_t changed) {
+#if defined(__AVR__)
+  uint8_t ports[RELAY_BANK_MAX];
+  uint8_t setMask[RELAY_BANK_MAX];
+  uint8_t clearMask[RELAY_BANK_MAX];
+  uint8_t portCount = 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (!(changed & (1UL << i))) {
+      continue;
+    }
+    bool high = levels & (1UL << i);
+    uint8_t port = digitalPinToPort(pins[i]);
+    uint8_t bit = digitalPinToBitMask(pins[i]);
+    uint8_t p = 0;
+    while (p < portCount && ports[p] != port) {
+      p++;
+    }
+    if (p == portCount) {
+      ports[p] = port;
+      setMask[p] = 0;
+      clearMask[p] = 0;
+      portCount++;
+    }
+    if (high) {
+      setMask[p] |= bit;
+    } else {
+      clearMask[p] |= bit;
+    }
+    GPIOShadow::record(pins[i], high ? HIGH : LOW);
+  }
+
+  uint8_t oldSREG = SREG;
+  cli();
+  for (uint8_t p = 0; p < portCount; p++) {
+    volatile uint8_t* out = portOutputRegister(ports[p]);
+    *out = (*out | setMask[p]) & ~clearMask[p];
+  }
+  SREG = oldSREG;
+
+#elif defined(ESP32)
+  uint32_t set0 = 0, clear0 = 0;
+  uint32_t set1 = 0, clear1 = 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (!(changed & (1UL << i))) {
+      continue;
+    }
+    bool high = levels & (1UL << i);
+    uint8_t pin = pins[i];
+    if (pin < 32) {
+      if (high) set0 |= (1UL << pin); else clear0 |= (1UL << pin);
+    } else {
+      if (high) set1 |= (1UL << (pin - 32)); else clear1 |= (1UL << (pin - 32));
+    }
+    GPIOShadow::record(pin, high ? HIGH : LOW);
+  }
+
+  // Write-1-to-clear / write-1-to-set registers, back to back
+  REG_WRITE(GPIO_OUT_W1TC_REG, clear0);
+  REG_WRITE(GPIO_OUT_W1TS_REG, set0);
+#if SOC_GPIO_PIN_COUNT > 32
+  REG_WRITE(GPIO_OUT1_W1TC_REG, clear1);
+  REG_WRITE(GPIO_OUT1_W1TS_REG, set1);
+#else
+  (void)set1;
+  (void)clear1;
+#endif
+
+#else
+  for (uint8_t i = 0; i < count; i++) {
+    if (changed & (1UL << i)) {
+      GPIOShadow::write(pins[i], (levels & (1UL << i)) ? HIGH : LOW);
+    }
+  }
+#endif
+}
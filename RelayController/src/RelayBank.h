@@ -0,0 +1,130 @@
+#ifndef RELAY_BANK_H
+#define RELAY_BANK_H
+
+#include <Arduino.h>
+
+#define RELAY_BANK_MAX 32            // relays per bank (one bit each)
+#define RELAY_BANK_MAX_INTERLOCKS 8  // mutually exclusive groups
+
+/**
+ * RelayBank
+ * Switches up to 32 relays as one state vector (bit i = relay i ON).
+ *
+ * apply() changes every relay in one step, so a group such as fan, heater
+ * and pump never passes through an in-between combination:
+ * - 74HC595 chain: all bits are shifted in, then latched with one pulse.
+ * - GPIO on AVR: one output register write per port, interrupts off.
+ * - GPIO on ESP32: one clear and one set register write (W1TC/W1TS).
+ * - GPIO on other boards: consecutive digitalWrite() calls.
+ *
+ * Interlocks (mutually exclusive relays) are checked when the state is
+ * applied; a state that breaks one is rejected and nothing is written.
+ *
+ * Hardware (74HC595):
+ * - DATA → SER (pin 14), CLOCK → SRCLK (pin 11), LATCH → RCLK (pin 12)
+ * - Chain boards via QH' → SER; relay 0 is output QA of the first chip
+ */
+class RelayBank {
+  private:
+    bool shiftRegister;       // true = 74HC595 chain, false = GPIO pins
+    bool started;             // begin() called, outputs are driven
+    uint8_t count;            // number of relays
+    uint8_t pins[RELAY_BANK_MAX];
+    uint8_t dataPin;
+    uint8_t clockPin;
+    uint8_t latchPin;
+    uint32_t state;           // logical state, bit i = relay i ON
+    uint32_t activeLow;       // bit i set = relay i energised by LOW
+    uint32_t interlocks[RELAY_BANK_MAX_INTERLOCKS];
+    uint8_t interlockCount;
+
+    void writeOutputs(uint32_t newState);
+    void writeShiftRegister(uint32_t levels);
+    void writePins(uint32_t levels, uint32_t changed);
+
+  public:
+    /**
+     * Constructor for relays on GPIO pins
+     * @param relayPins Array of GPIO pins, relay 0 first
+     * @param relayCount Number of relays (max 32)
+     * @param invertLogic Set true for active-low relay modules
+     */
+    RelayBank(const uint8_t* relayPins, uint8_t relayCount, bool invertLogic = false);
+
+    /**
+     * Constructor for relays behind a 74HC595 shift register chain
+     * @param data GPIO connected to SER
+     * @param clock GPIO connected to SRCLK
+     * @param latch GPIO connected to RCLK
+     * @param relayCount Number of relays (max 32, 8 per chip)
+     * @param invertLogic Set true for active-low relay boards
+     */
+    RelayBank(uint8_t data, uint8_t clock, uint8_t latch, uint8_t relayCount, bool invertLogic = false);
+
+    /**
+     * Initialize outputs with all relays OFF (call in setup())
+     */
+    void begin();
+
+    /**
+     * Set the logic of a single relay (for mixed active-high/low boards).
+     * After begin() the output is re-driven to match the current state.
+     * @param index Relay index
+     * @param invertLogic true = active-low
+     */
+    void setInverted(uint8_t index, bool invertLogic);
+
+    /**
+     * Declare a group of mutually exclusive relays
+     * @param mask Bit mask of relays; at most one of them may be ON
+     * @return false if the interlock table is full
+     */
+    bool addInterlock(uint32_t mask);
+
+    /**
+     * Check a state against all interlocks
+     * @param newState State vector to check
+     * @return true if no interlock is violated
+     */
+    bool isAllowed(uint32_t newState) const;
+
+    /**
+     * Apply a whole new state vector in one step
+     * @param newState Bit i = relay i ON
+     * @return false if an interlock would be violated (nothing changes)
+     */
+    bool apply(uint32_t newState);
+
+    /**
+     * Switch a single relay (other relays keep their state)
+     * @param index Relay index
+     * @param on true = ON
+     * @return false if an interlock would be violated
+     */
+    bool set(uint8_t index, bool on);
+
+    /**
+     * Turn every relay OFF (always allowed)
+     */
+    void allOff();
+
+    /**
+     * Get the current state vector
+     * @return Bit i = relay i ON
+     */
+    uint32_t getState() const;
+
+    /**
+     * Get the state of a single relay
+     * @param index Relay index
+     * @return true if ON
+     */
+    bool isOn(uint8_t index) const;
+
+    /**
+     * Number of relays in the bank
+     */
+    uint8_t size() const;
+};
+
+#endif // RELAY_BANK_H
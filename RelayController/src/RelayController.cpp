@@ -1,30 +1,32 @@
 #include "RelayController.h"
+#include <GPIOShadow.h>
 
 RelayController::RelayController(uint8_t pinNumber, bool invertLogic)
-: pin(pinNumber), state(false), inverted(invertLogic) {
+: pin(pinNumber), state(false), inverted(invertLogic),
+  switchCount(0), onSeconds(0), onMsCarry(0), onSince(0) {
 }
 
 void RelayController::begin() {
   pinMode(pin, OUTPUT);
+  GPIOShadow::forget(pin);
   off(); // Start with relay off (safe default)
 }
 
 void RelayController::on() {
-  state = true;
-  if (inverted) {
-    digitalWrite(pin, LOW);
-  } else {
-    digitalWrite(pin, HIGH);
+  if (!state) {
+    switchCount++;
+    onSince = millis();
   }
+  state = true;
+  GPIOShadow::write(pin, inverted ? LOW : HIGH);
 }
 
 void RelayController::off() {
-  state = false;
-  if (inverted) {
-    digitalWrite(pin, HIGH);
-  } else {
-    digitalWrite(pin, LOW);
+  if (state) {
+    accumulateOnTime(millis());
   }
+  state = false;
+  GPIOShadow::write(pin, inverted ? HIGH : LOW);
 }
 
 void RelayController::toggle() {
@@ -46,3 +48,28 @@ void RelayController::setState(bool newState) {
     off();
   }
 }
+
+uint32_t RelayController::getSwitchCount() const {
+  return switchCount;
+}
+
+uint32_t RelayController::getOnTime() {
+  if (state) {
+    accumulateOnTime(millis());
+  }
+  return onSeconds;
+}
+
+void RelayController::restoreCounters(uint32_t switches, uint32_t onTimeSeconds) {
+  switchCount = switches;
+  onSeconds = onTimeSeconds;
+  onMsCarry = 0;
+  onSince = millis();
+}
+
+void RelayController::accumulateOnTime(unsigned long now) {
+  unsigned long ms = (now - onSince) + onMsCarry;
+  onSeconds += ms / 1000;
+  onMsCarry = ms % 1000;
+  onSince = now;
+}
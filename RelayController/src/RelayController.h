@@ -23,6 +23,12 @@ class RelayController {
     uint8_t pin;
     bool state;           // Current relay state (true = ON)
     bool inverted;        // Invert logic (for active-low modules)
+    uint32_t switchCount; // Number of OFF -> ON operations
+    uint32_t onSeconds;   // Accumulated ON time (completed seconds)
+    uint16_t onMsCarry;   // Sub-second remainder of the ON time
+    unsigned long onSince; // millis() of the last ON time accumulation
+
+    void accumulateOnTime(unsigned long now);
 
   public:
     /**
@@ -63,6 +69,28 @@ class RelayController {
      * @param newState true = ON, false = OFF
      */
     void setState(bool newState);
+
+    /**
+     * Get the number of switch operations (OFF -> ON transitions)
+     * @return Switch count since begin() or the last restoreCounters()
+     */
+    uint32_t getSwitchCount() const;
+
+    /**
+     * Get the accumulated ON time, including the current ON period.
+     * Folds the running period into the total, so ON periods longer
+     * than the 49-day millis() wrap are counted as long as this is
+     * called at least once per wrap (RelayLog does).
+     * @return ON time in seconds
+     */
+    uint32_t getOnTime();
+
+    /**
+     * Set the counters, e.g. from a persistent log after a reboot
+     * @param switches Switch count
+     * @param onTimeSeconds Accumulated ON time in seconds
+     */
+    void restoreCounters(uint32_t switches, uint32_t onTimeSeconds);
 };
 
 #endif // RELAY_CONTROLLER_H
@@ -0,0 +1,165 @@
+#include "RelayLog.h"
+
+#define RELAY_LOG_RECORD_MAX (6 + 8 * RELAY_LOG_MAX)
+
+// CRC-8 (polynomial 0x07), non-zero start so erased 0xFF bytes never pass
+static uint8_t crc8(const uint8_t* data, uint16_t len) {
+  uint8_t crc = 0x5A;
+  for (uint16_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+RelayLog::RelayLog(RelayLogStorage& store, unsigned long flushIntervalMs)
+: storage(&store), count(0), intervalMs(flushIntervalMs), lastFlush(0),
+  seq(0), nextSlot(0), writes(0) {
+}
+
+bool RelayLog::attach(RelayController& relay) {
+  if (count >= RELAY_LOG_MAX) {
+    return false;
+  }
+  relays[count] = &relay;
+  savedSwitches[count] = 0;
+  savedOnTime[count] = 0;
+  count++;
+  return true;
+}
+
+// Record: seq (4) | relay count (1) | per relay: switches (4), ON seconds (4) | CRC (1)
+uint16_t RelayLog::recordSize() const {
+  return 6 + 8 * count;
+}
+
+uint16_t RelayLog::slotCount() const {
+  return storage->size() / recordSize();
+}
+
+bool RelayLog::readRecord(uint16_t slot, uint8_t* buf, uint32_t& recordSeq) {
+  uint16_t len = recordSize();
+  if (!storage->read(slot * len, buf, len)) {
+    return false;
+  }
+  if (buf[4] != count || crc8(buf, len - 1) != buf[len - 1]) {
+    return false;
+  }
+  recordSeq = get32(buf);
+  return true;
+}
+
+bool RelayLog::begin() {
+  lastFlush = millis();
+  writes = 0;
+  seq = 0;
+  nextSlot = 0;
+
+  if (count == 0 || !storage->begin() || slotCount() == 0) {
+    return false;
+  }
+
+  // Find the newest valid record (sequence numbers compared wrap-safe)
+  uint8_t buf[RELAY_LOG_RECORD_MAX];
+  uint8_t best[RELAY_LOG_RECORD_MAX];
+  bool found = false;
+  uint32_t bestSeq = 0;
+  uint16_t bestSlot = 0;
+
+  for (uint16_t slot = 0; slot < slotCount(); slot++) {
+    uint32_t recordSeq;
+    if (!readRecord(slot, buf, recordSeq)) {
+      continue;
+    }
+    if (!found || (int32_t)(recordSeq - bestSeq) > 0) {
+      found = true;
+      bestSeq = recordSeq;
+      bestSlot = slot;
+      memcpy(best, buf, recordSize());
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    savedSwitches[i] = get32(best + 5 + 8 * i);
+    savedOnTime[i] = get32(best + 9 + 8 * i);
+    relays[i]->restoreCounters(savedSwitches[i], savedOnTime[i]);
+  }
+  seq = bestSeq + 1;
+  nextSlot = (bestSlot + 1) % slotCount();
+  return true;
+}
+
+void RelayLog::update() {
+  if (millis() - lastFlush >= intervalMs) {
+    flush();
+  }
+}
+
+bool RelayLog::flush() {
+  lastFlush = millis();
+  if (count == 0 || slotCount() == 0) {
+    return false;
+  }
+
+  uint8_t buf[RELAY_LOG_RECORD_MAX];
+  bool changed = false;
+
+  put32(buf, seq);
+  buf[4] = count;
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t switches = relays[i]->getSwitchCount();
+    uint32_t onTime = relays[i]->getOnTime();
+    if (switches != savedSwitches[i] || onTime != savedOnTime[i]) {
+      changed = true;
+    }
+    put32(buf + 5 + 8 * i, switches);
+    put32(buf + 9 + 8 * i, onTime);
+  }
+  if (!changed) {
+    return true;
+  }
+
+  uint16_t len = recordSize();
+  buf[len - 1] = crc8(buf, len - 1);
+  if (!storage->write(nextSlot * len, buf, len)) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    savedSwitches[i] = get32(buf + 5 + 8 * i);
+    savedOnTime[i] = get32(buf + 9 + 8 * i);
+  }
+  seq++;
+  nextSlot = (nextSlot + 1) % slotCount();
+  writes++;
+  return true;
+}
+
+void RelayLog::setFlushInterval(unsigned long ms) {
+  intervalMs = ms;
+}
+
+uint32_t RelayLog::getWriteCount() const {
+  return writes;
+}
+
+uint16_t RelayLog::getSlotCount() const {
+  return count ? slotCount() : 0;
+}
@@ -0,0 +1,95 @@
+#ifndef RELAY_LOG_H
+#define RELAY_LOG_H
+
+#include <Arduino.h>
+#include "RelayController.h"
+#include "RelayLogStorage.h"
+
+#define RELAY_LOG_MAX 8  // relays per log
+
+/**
+ * RelayLog
+ * Keeps the switch counts and ON times of several RelayControllers across
+ * reboots.
+ *
+ * The counters live in RAM (RelayController). RelayLog writes a snapshot of
+ * all of them as one record at most once per flush interval, and only if
+ * something changed, so toggling a relay never causes a flash write of its
+ * own. Records are appended around the storage region; the one with the
+ * highest sequence number wins at begin(). Each record carries a CRC, so a
+ * write cut short by a power loss is skipped and the previous record is used.
+ *
+ * Flash budget: with R relays a record takes 6 + 8 * R bytes. A 1 KB AVR
+ * EEPROM holds 14 records of 8 relays; at one write per 15 minutes each
+ * cell sees ~2500 writes per year (rated 100,000).
+ */
+class RelayLog {
+  private:
+    RelayLogStorage* storage;
+    RelayController* relays[RELAY_LOG_MAX];
+    uint32_t savedSwitches[RELAY_LOG_MAX]; // values in the last record
+    uint32_t savedOnTime[RELAY_LOG_MAX];
+    uint8_t count;
+    unsigned long intervalMs;
+    unsigned long lastFlush;
+    uint32_t seq;             // sequence number of the next record
+    uint16_t nextSlot;        // slot of the next record
+    uint32_t writes;          // records written since begin()
+
+    uint16_t recordSize() const;
+    uint16_t slotCount() const;
+    bool readRecord(uint16_t slot, uint8_t* buf, uint32_t& recordSeq);
+
+  public:
+    /**
+     * Constructor
+     * @param store Storage backend (RelayLogEEPROM, RelayLogFlash, RelayLogFile)
+     * @param flushIntervalMs Minimum time between record writes (default 15 min)
+     */
+    RelayLog(RelayLogStorage& store, unsigned long flushIntervalMs = 900000UL);
+
+    /**
+     * Add a relay (always attach the same relays in the same order,
+     * a different layout does not match the stored records)
+     * @param relay Relay to account
+     * @return false if the log is full
+     */
+    bool attach(RelayController& relay);
+
+    /**
+     * Open the storage and restore the counters of all attached relays
+     * from the newest valid record (call in setup() after attach())
+     * @return true if counters were restored, false if the log was empty
+     */
+    bool begin();
+
+    /**
+     * Write a record if the flush interval has passed and a counter
+     * changed (call regularly in loop())
+     */
+    void update();
+
+    /**
+     * Write a record now if a counter changed (e.g. before a planned
+     * shutdown)
+     * @return false on a storage error
+     */
+    bool flush();
+
+    /**
+     * Set the minimum time between record writes
+     */
+    void setFlushInterval(unsigned long ms);
+
+    /**
+     * Number of records written since begin()
+     */
+    uint32_t getWriteCount() const;
+
+    /**
+     * Number of record slots in the storage region
+     */
+    uint16_t getSlotCount() const;
+};
+
+#endif // RELAY_LOG_H
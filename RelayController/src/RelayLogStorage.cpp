@@ -0,0 +1,154 @@
+#include "RelayLogStorage.h"
+
+#if defined(ESP32)
+#include <LittleFS.h>
+#endif
+
+#if defined(__AVR__)
+
+RelayLogEEPROM::RelayLogEEPROM(uint16_t startAddr, uint16_t regionLength)
+: start(startAddr), length(regionLength) {
+  uint16_t available = (E2END + 1) - start;
+  if (length == 0 || length > available) {
+    length = available;
+  }
+}
+
+uint16_t RelayLogEEPROM::size() const {
+  return length;
+}
+
+bool RelayLogEEPROM::read(uint16_t addr, uint8_t* data, uint16_t len) {
+  if ((uint32_t)addr + len > length) {
+    return false;
+  }
+  for (uint16_t i = 0; i < len; i++) {
+    data[i] = EEPROM.read(start + addr + i);
+  }
+  return true;
+}
+
+bool RelayLogEEPROM::write(uint16_t addr, const uint8_t* data, uint16_t len) {
+  if ((uint32_t)addr + len > length) {
+    return false;
+  }
+  for (uint16_t i = 0; i < len; i++) {
+    EEPROM.update(start + addr + i, data[i]);
+  }
+  return true;
+}
+
+#elif defined(ESP32)
+
+RelayLogFlash::RelayLogFlash(const char* filePath, uint16_t regionLength, fs::FS* fileSystem)
+: fs(fileSystem), path(filePath), length(regionLength), mounted(false) {
+}
+
+bool RelayLogFlash::begin() {
+  if (fs == NULL) {
+    if (!LittleFS.begin(true)) { // format on first use
+      return false;
+    }
+    fs = &LittleFS;
+  }
+
+  // Create the file at full size, erased (0xFF)
+  if (!fs->exists(path)) {
+    File f = fs->open(path, FILE_WRITE);
+    if (!f) {
+      return false;
+    }
+    uint8_t blank[32];
+    memset(blank, 0xFF, sizeof(blank));
+    for (uint16_t done = 0; done < length; done += sizeof(blank)) {
+      uint16_t n = min((uint16_t)sizeof(blank), (uint16_t)(length - done));
+      f.write(blank, n);
+    }
+    f.close();
+  }
+  mounted = true;
+  return true;
+}
+
+uint16_t RelayLogFlash::size() const {
+  return length;
+}
+
+bool RelayLogFlash::read(uint16_t addr, uint8_t* data, uint16_t len) {
+  if (!mounted || (uint32_t)addr + len > length) {
+    return false;
+  }
+  File f = fs->open(path, FILE_READ);
+  if (!f) {
+    return false;
+  }
+  bool ok = f.seek(addr) && f.read(data, len) == len;
+  f.close();
+  return ok;
+}
+
+bool RelayLogFlash::write(uint16_t addr, const uint8_t* data, uint16_t len) {
+  if (!mounted || (uint32_t)addr + len > length) {
+    return false;
+  }
+  File f = fs->open(path, "r+");
+  if (!f) {
+    return false;
+  }
+  bool ok = f.seek(addr) && f.write(data, len) == len;
+  f.close();
+  return ok;
+}
+
+#endif
+
+#if !defined(ARDUINO)
+
+RelayLogFile::RelayLogFile(const char* filePath, uint16_t regionLength)
+: path(filePath), length(regionLength), file(NULL) {
+}
+
+RelayLogFile::~RelayLogFile() {
+  if (file) {
+    fclose(file);
+  }
+}
+
+bool RelayLogFile::begin() {
+  file = fopen(path, "r+b");
+  if (file == NULL) {
+    // Create the file at full size, erased (0xFF)
+    file = fopen(path, "w+b");
+    if (file == NULL) {
+      return false;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+      fputc(0xFF, file);
+    }
+    fflush(file);
+  }
+  return true;
+}
+
+uint16_t RelayLogFile::size() const {
+  return length;
+}
+
+bool RelayLogFile::read(uint16_t addr, uint8_t* data, uint16_t len) {
+  if (file == NULL || (uint32_t)addr + len > length) {
+    return false;
+  }
+  return fseek(file, addr, SEEK_SET) == 0 && fread(data, 1, len, file) == len;
+}
+
+bool RelayLogFile::write(uint16_t addr, const uint8_t* data, uint16_t len) {
+  if (file == NULL || (uint32_t)addr + len > length) {
+    return false;
+  }
+  if (fseek(file, addr, SEEK_SET) != 0 || fwrite(data, 1, len, file) != len) {
+    return false;
+  }
+  return fflush(file) == 0;
+}
+
+#endif
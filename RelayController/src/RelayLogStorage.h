@@ -0,0 +1,132 @@
+#ifndef RELAY_LOG_STORAGE_H
+#define RELAY_LOG_STORAGE_H
+
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <EEPROM.h>
+#elif defined(ESP32)
+#include <FS.h>
+#endif
+
+#if !defined(ARDUINO)
+#include <stdio.h>
+#endif
+
+/**
+ * RelayLogStorage
+ * Byte-addressable storage region used by RelayLog. RelayLog only
+ * appends fixed-size records around the region, so every byte is written
+ * equally often (wear leveling by ring).
+ */
+class RelayLogStorage {
+  public:
+    virtual ~RelayLogStorage() {}
+
+    /**
+     * Prepare the storage (mount, open, create)
+     * @return true on success
+     */
+    virtual bool begin() { return true; }
+
+    /**
+     * Size of the region in bytes
+     */
+    virtual uint16_t size() const = 0;
+
+    /**
+     * Read bytes from the region
+     * @return true on success
+     */
+    virtual bool read(uint16_t addr, uint8_t* data, uint16_t len) = 0;
+
+    /**
+     * Write bytes to the region
+     * @return true on success
+     */
+    virtual bool write(uint16_t addr, const uint8_t* data, uint16_t len) = 0;
+};
+
+#if defined(__AVR__)
+/**
+ * RelayLogEEPROM
+ * Log region in the AVR EEPROM. Bytes that already hold the value are not
+ * rewritten (EEPROM.update), which saves a cell cycle per unchanged byte.
+ */
+class RelayLogEEPROM : public RelayLogStorage {
+  private:
+    uint16_t start;
+    uint16_t length;
+
+  public:
+    /**
+     * Constructor
+     * @param startAddr First EEPROM address of the region
+     * @param regionLength Region size in bytes (default: rest of the EEPROM)
+     */
+    RelayLogEEPROM(uint16_t startAddr = 0, uint16_t regionLength = 0);
+
+    uint16_t size() const;
+    bool read(uint16_t addr, uint8_t* data, uint16_t len);
+    bool write(uint16_t addr, const uint8_t* data, uint16_t len);
+};
+
+#elif defined(ESP32)
+/**
+ * RelayLogFlash
+ * Log region in a fixed-size file on an ESP32 flash file system
+ * (LittleFS by default). The file is created on first use.
+ */
+class RelayLogFlash : public RelayLogStorage {
+  private:
+    fs::FS* fs;
+    const char* path;
+    uint16_t length;
+    bool mounted;
+
+  public:
+    /**
+     * Constructor
+     * @param path File path, e.g. "/relaylog.bin"
+     * @param regionLength File size in bytes
+     * @param fileSystem File system (must be mounted; default LittleFS,
+     *                   mounted and formatted if needed by begin())
+     */
+    RelayLogFlash(const char* path = "/relaylog.bin", uint16_t regionLength = 4096,
+                  fs::FS* fileSystem = NULL);
+
+    bool begin();
+    uint16_t size() const;
+    bool read(uint16_t addr, uint8_t* data, uint16_t len);
+    bool write(uint16_t addr, const uint8_t* data, uint16_t len);
+};
+#endif
+
+#if !defined(ARDUINO)
+/**
+ * RelayLogFile
+ * Log region in a plain file, for host builds and simulation.
+ */
+class RelayLogFile : public RelayLogStorage {
+  private:
+    const char* path;
+    uint16_t length;
+    FILE* file;
+
+  public:
+    /**
+     * Constructor
+     * @param path File path
+     * @param regionLength File size in bytes
+     */
+    RelayLogFile(const char* path, uint16_t regionLength = 4096);
+    ~RelayLogFile();
+
+    bool begin();
+    uint16_t size() const;
+    bool read(uint16_t addr, uint8_t* data, uint16_t len);
+    bool write(uint16_t addr, const uint8_t* data, uint16_t len);
+};
+#endif
+
+#endif // RELAY_LOG_STORAGE_H
@@ -0,0 +1,154 @@
+#include "RelayPWM.h"
+
+RelayPWM::RelayPWM(unsigned long window, unsigned long minPulse)
+: count(0), windowMs(window ? window : 1), nextWindowMs(windowMs), minPulseMs(minPulse), interleaved(true),
+  running(false), windowStart(0), nextEdge(0) {
+}
+
+int8_t RelayPWM::add(RelayController& relay) {
+  if (count >= RELAY_PWM_MAX) {
+    return -1;
+  }
+  Channel& c = channels[count];
+  c.relay = &relay;
+  c.duty = 0;
+  c.onMs = 0;
+  c.offset = 0;
+  c.headOn = false;
+  return count++;
+}
+
+void RelayPWM::begin() {
+  running = true;
+  windowStart = millis();
+  startWindow();
+  apply(0);
+}
+
+void RelayPWM::stop() {
+  running = false;
+  for (uint8_t i = 0; i < count; i++) {
+    channels[i].relay->off();
+  }
+}
+
+void RelayPWM::setDuty(uint8_t id, float percent) {
+  if (id >= count) {
+    return;
+  }
+  channels[id].duty = constrain(percent, 0.0f, 100.0f);
+}
+
+float RelayPWM::getDuty(uint8_t id) const {
+  return (id < count) ? channels[id].duty : 0;
+}
+
+void RelayPWM::setWindow(unsigned long ms) {
+  nextWindowMs = ms ? ms : 1;
+}
+
+void RelayPWM::setMinPulse(unsigned long ms) {
+  minPulseMs = ms;
+}
+
+void RelayPWM::setInterleaved(bool enable) {
+  interleaved = enable;
+}
+
+// Latch ON times and offsets for the window beginning at windowStart
+void RelayPWM::startWindow() {
+  unsigned long offset = 0;
+  windowMs = nextWindowMs;
+
+  for (uint8_t i = 0; i < count; i++) {
+    Channel& c = channels[i];
+    unsigned long on = (unsigned long)(c.duty * windowMs / 100.0f + 0.5f);
+    if (on > windowMs) {
+      on = windowMs;
+    }
+    // Minimum pulse suppression
+    if (on < minPulseMs) {
+      on = 0;
+    } else if (windowMs - on < minPulseMs) {
+      on = windowMs;
+    }
+    c.onMs = on;
+    c.offset = interleaved ? offset : 0;
+    // Relays still hold the previous window's end state here
+    c.headOn = c.relay->isOn();
+    offset = (offset + on) % windowMs;
+  }
+}
+
+// ON interval is circular within the window: [offset, offset + onMs). The
+// part wrapped to the window start is only on when it continues a pulse.
+bool RelayPWM::stateAt(const Channel& c, unsigned long t) const {
+  if (c.onMs == 0) {
+    return false;
+  }
+  if (c.onMs >= windowMs) {
+    return true;
+  }
+  unsigned long end = c.offset + c.onMs;
+  if (t < c.offset) {
+    return end > windowMs && c.headOn && t < end - windowMs;
+  }
+  return t < end;
+}
+
+// Set every relay for window time t and find the next edge
+void RelayPWM::apply(unsigned long t) {
+  unsigned long next = windowMs;
+
+  for (uint8_t i = 0; i < count; i++) {
+    Channel& c = channels[i];
+    c.relay->setState(stateAt(c, t));
+
+    if (c.onMs == 0 || c.onMs >= windowMs) {
+      continue;
+    }
+    unsigned long onEdge = c.offset;
+    unsigned long offEdge = (c.offset + c.onMs) % windowMs;
+    if (c.offset + c.onMs > windowMs && !c.headOn) {
+      offEdge = 0; // wrapped part skipped, no edge
+    }
+    if (onEdge > t && onEdge < next) {
+      next = onEdge;
+    }
+    if (offEdge > t && offEdge < next) {
+      next = offEdge;
+    }
+  }
+  nextEdge = windowStart + next;
+}
+
+void RelayPWM::update() {
+  if (!running) {
+    return;
+  }
+  unsigned long now = millis();
+  if ((long)(now - nextEdge) < 0) {
+    return;
+  }
+
+  unsigned long t = now - windowStart;
+  if (t >= windowMs) {
+    // Skip whole windows if update() was not called for a while
+    windowStart += (t / windowMs) * windowMs;
+    t = now - windowStart;
+    if (nextWindowMs != windowMs) {
+      windowStart = now; // new length starts a fresh window
+      t = 0;
+    }
+    startWindow();
+  }
+  apply(t);
+}
+
+unsigned long RelayPWM::msToNextEdge() const {
+  if (!running) {
+    return 0;
+  }
+  long wait = (long)(nextEdge - millis());
+  return (wait > 0) ? (unsigned long)wait : 0;
+}
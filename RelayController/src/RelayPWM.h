@@ -0,0 +1,123 @@
+#ifndef RELAY_PWM_H
+#define RELAY_PWM_H
+
+#include <Arduino.h>
+#include "RelayController.h"
+
+#define RELAY_PWM_MAX 8  // relays per time-proportioning group
+
+/**
+ * RelayPWM
+ * Time-proportional ("slow PWM") output for relays: a 0-100 % duty is
+ * turned into ON time per window, e.g. 30 % of a 10 s window = 3 s ON,
+ * 7 s OFF. Heaters then get proportional power instead of bang-bang
+ * switching with its overshoot.
+ *
+ * All relays of a group share the window. Duty changes are taken over at
+ * the next window start, so a window is never cut short.
+ * - Minimum pulse: ON or OFF times shorter than minPulseMs are dropped
+ *   (duty rounds to 0 % or 100 %) to spare the contacts.
+ * - Interleaving: the ON times of the relays are placed one after the
+ *   other within the window instead of all starting together, so their
+ *   loads overlap as little as possible (not at all while the total duty
+ *   is <= 100 %). An ON time that runs past the window end continues at
+ *   the next window start. That wrapped part is only switched on when it
+ *   extends a pulse already ON at the window end (not in the first window,
+ *   or when a duty change moved the offsets), so it never becomes a
+ *   separate pulse shorter than the minimum.
+ *
+ * The next switching time is computed in advance; update() is a single
+ * time comparison until it is due. msToNextEdge() tells how long the
+ * caller may sleep.
+ */
+class RelayPWM {
+  private:
+    struct Channel {
+      RelayController* relay;
+      float duty;             // requested duty, 0-100 %
+      unsigned long onMs;     // ON time latched for the current window
+      unsigned long offset;   // start of the ON time within the window
+      bool headOn;            // wrapped part at the window start is switched on
+    };
+
+    Channel channels[RELAY_PWM_MAX];
+    uint8_t count;
+    unsigned long windowMs;   // window length in use
+    unsigned long nextWindowMs; // window length from the next window start
+    unsigned long minPulseMs;
+    bool interleaved;
+    bool running;
+    unsigned long windowStart;
+    unsigned long nextEdge;   // millis() of the next switching or window start
+
+    void startWindow();
+    bool stateAt(const Channel& c, unsigned long t) const;
+    void apply(unsigned long t);
+
+  public:
+    /**
+     * Constructor
+     * @param window Window length in ms (e.g. 10000)
+     * @param minPulse Shortest ON or OFF time in ms (0 = no limit)
+     */
+    RelayPWM(unsigned long window = 10000, unsigned long minPulse = 0);
+
+    /**
+     * Add a relay (call begin() on it first)
+     * @param relay Relay to drive
+     * @return Channel id, or -1 if the group is full
+     */
+    int8_t add(RelayController& relay);
+
+    /**
+     * Start the first window now
+     */
+    void begin();
+
+    /**
+     * Stop time proportioning and turn every relay OFF
+     */
+    void stop();
+
+    /**
+     * Set the duty of a channel (used from the next window start)
+     * @param id Channel id
+     * @param percent Duty 0-100 %
+     */
+    void setDuty(uint8_t id, float percent);
+
+    /**
+     * Get the requested duty of a channel
+     * @return Duty 0-100 %
+     */
+    float getDuty(uint8_t id) const;
+
+    /**
+     * Set the window length (used from the next window start)
+     */
+    void setWindow(unsigned long ms);
+
+    /**
+     * Set the shortest ON or OFF time
+     */
+    void setMinPulse(unsigned long ms);
+
+    /**
+     * Place the ON times of the channels one after the other
+     * @param enable true = interleaved, false = all start at the window start
+     */
+    void setInterleaved(bool enable);
+
+    /**
+     * Switch relays when due (call regularly in loop())
+     */
+    void update();
+
+    /**
+     * Time until update() has something to do
+     * @return Milliseconds (0 = due now)
+     */
+    unsigned long msToNextEdge() const;
+};
+
+#endif // RELAY_PWM_H
@@ -0,0 +1,174 @@
+#include "RelayScheduler.h"
+
+// Time left until `need` ms have passed since `since` (wrap-safe)
+static unsigned long remaining(unsigned long since, unsigned long need, unsigned long now) {
+  unsigned long elapsed = now - since;
+  return (elapsed >= need) ? 0 : need - elapsed;
+}
+
+// Request order comparison that survives uint16_t wrap-around
+static bool seqBefore(uint16_t a, uint16_t b) {
+  return (int16_t)(a - b) < 0;
+}
+
+RelayScheduler::RelayScheduler(unsigned long minSpacingMs)
+: count(0), spacingMs(minSpacingMs), lastAnyOn(0 - minSpacingMs), nextSeq(0) {
+}
+
+int8_t RelayScheduler::add(RelayController& relay, unsigned long minOnMs,
+                           unsigned long minOffMs, uint8_t maxStartsPerHour) {
+  if (count >= RELAY_SCHEDULER_MAX) {
+    return -1;
+  }
+
+  unsigned long now = millis();
+  Entry& e = entries[count];
+  e.relay = &relay;
+  e.minOnMs = minOnMs;
+  e.minOffMs = minOffMs;
+  e.minStartMs = maxStartsPerHour ? (3600000UL / maxStartsPerHour) : 0;
+  // Pretend the last switches happened long enough ago
+  e.lastOn = now - max(minOnMs, e.minStartMs);
+  e.lastOff = now - minOffMs;
+  e.seq = 0;
+  e.pending = false;
+  e.pendingState = false;
+  return count++;
+}
+
+unsigned long RelayScheduler::readyIn(const Entry& e, unsigned long now) const {
+  if (e.pendingState) {
+    unsigned long offWait = remaining(e.lastOff, e.minOffMs, now);
+    unsigned long startWait = remaining(e.lastOn, e.minStartMs, now);
+    return max(offWait, startWait);
+  }
+  return remaining(e.lastOn, e.minOnMs, now);
+}
+
+unsigned long RelayScheduler::request(uint8_t id, bool on) {
+  if (id >= count) {
+    return millis();
+  }
+
+  Entry& e = entries[id];
+  if (e.relay->isOn() == on) {
+    e.pending = false; // already there, drop any opposite request
+    return millis();
+  }
+
+  if (!e.pending || e.pendingState != on) {
+    e.seq = nextSeq++;
+  }
+  e.pending = true;
+  e.pendingState = on;
+
+  update();
+  return effectiveAt(id);
+}
+
+void RelayScheduler::forceOff(uint8_t id) {
+  if (id >= count) {
+    return;
+  }
+  if (entries[id].relay->isOn()) {
+    switchRelay(id, false, millis());
+  }
+  entries[id].pending = false;
+}
+
+void RelayScheduler::cancel(uint8_t id) {
+  if (id < count) {
+    entries[id].pending = false;
+  }
+}
+
+bool RelayScheduler::isPending(uint8_t id) const {
+  return id < count && entries[id].pending;
+}
+
+unsigned long RelayScheduler::effectiveAt(uint8_t id) const {
+  unsigned long now = millis();
+  if (id >= count || !entries[id].pending) {
+    return now;
+  }
+
+  const Entry& target = entries[id];
+  if (!target.pendingState) {
+    return now + readyIn(target, now);
+  }
+
+  // Replay the ON release order that update() will follow: one ON per
+  // spacing slot, the earliest-ready request first, ties in request order.
+  bool released[RELAY_SCHEDULER_MAX] = { false };
+  unsigned long slot = remaining(lastAnyOn, spacingMs, now);
+
+  for (uint8_t round = 0; round < count; round++) {
+    int8_t pick = -1;
+    unsigned long pickAt = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+      const Entry& e = entries[i];
+      if (!e.pending || !e.pendingState || released[i]) {
+        continue;
+      }
+      unsigned long at = max(readyIn(e, now), slot);
+      if (pick < 0 || at < pickAt || (at == pickAt && seqBefore(e.seq, entries[pick].seq))) {
+        pick = i;
+        pickAt = at;
+      }
+    }
+
+    if (pick < 0) {
+      break;
+    }
+    if (pick == id) {
+      return now + pickAt;
+    }
+    released[pick] = true;
+    slot = pickAt + spacingMs;
+  }
+
+  return now; // not reached
+}
+
+void RelayScheduler::update() {
+  unsigned long now = millis();
+
+  // OFF requests only wait for their own minimum ON time
+  for (uint8_t i = 0; i < count; i++) {
+    Entry& e = entries[i];
+    if (e.pending && !e.pendingState && readyIn(e, now) == 0) {
+      switchRelay(i, false, now);
+    }
+  }
+
+  // At most one switch-ON per spacing slot
+  if (remaining(lastAnyOn, spacingMs, now) > 0) {
+    return;
+  }
+
+  int8_t pick = -1;
+  for (uint8_t i = 0; i < count; i++) {
+    Entry& e = entries[i];
+    if (e.pending && e.pendingState && readyIn(e, now) == 0) {
+      if (pick < 0 || seqBefore(e.seq, entries[pick].seq)) {
+        pick = i;
+      }
+    }
+  }
+  if (pick >= 0) {
+    switchRelay(pick, true, now);
+  }
+}
+
+void RelayScheduler::switchRelay(uint8_t id, bool on, unsigned long now) {
+  Entry& e = entries[id];
+  e.relay->setState(on);
+  e.pending = false;
+  if (on) {
+    e.lastOn = now;
+    lastAnyOn = now;
+  } else {
+    e.lastOff = now;
+  }
+}
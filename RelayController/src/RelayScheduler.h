@@ -0,0 +1,107 @@
+#ifndef RELAY_SCHEDULER_H
+#define RELAY_SCHEDULER_H
+
+#include <Arduino.h>
+#include "RelayController.h"
+
+#define RELAY_SCHEDULER_MAX 8  // relays per scheduler
+
+/**
+ * RelayScheduler
+ * Queues ON/OFF requests for several RelayControllers and releases them
+ * under protection rules:
+ * - Inrush staggering: at least `minSpacingMs` between any two switch-ONs,
+ *   so coils and loads never energise in the same instant.
+ * - Minimum ON time per relay (OFF requests wait for it).
+ * - Minimum OFF time per relay (ON requests wait for it).
+ * - Maximum starts per hour, enforced as a minimum start-to-start time of
+ *   3600 s / maxStarts (the usual compressor "cycle rate" rule).
+ *
+ * Requests do not block: update() switches relays when they become due and
+ * effectiveAt() reports when a queued request will take effect.
+ * Switch-ONs that are due together are released one per spacing slot,
+ * earliest-ready first, then in request order.
+ */
+class RelayScheduler {
+  private:
+    struct Entry {
+      RelayController* relay;
+      unsigned long minOnMs;
+      unsigned long minOffMs;
+      unsigned long minStartMs;   // start-to-start time from max starts/hour
+      unsigned long lastOn;       // time of last switch-ON
+      unsigned long lastOff;      // time of last switch-OFF
+      uint16_t seq;               // request order of the pending request
+      bool pending;
+      bool pendingState;
+    };
+
+    Entry entries[RELAY_SCHEDULER_MAX];
+    uint8_t count;
+    unsigned long spacingMs;
+    unsigned long lastAnyOn;      // time of last switch-ON of any relay
+    uint16_t nextSeq;
+
+    unsigned long readyIn(const Entry& e, unsigned long now) const;
+    void switchRelay(uint8_t id, bool on, unsigned long now);
+
+  public:
+    /**
+     * Constructor
+     * @param minSpacingMs Minimum time between switch-ONs of any two relays
+     */
+    explicit RelayScheduler(unsigned long minSpacingMs = 500);
+
+    /**
+     * Add a relay (call begin() on the relay first)
+     * @param relay Relay to schedule
+     * @param minOnMs Minimum ON time before it may switch OFF
+     * @param minOffMs Minimum OFF time before it may switch ON again
+     * @param maxStartsPerHour Maximum switch-ONs per hour (0 = no limit)
+     * @return Relay id for request(), or -1 if the scheduler is full
+     */
+    int8_t add(RelayController& relay, unsigned long minOnMs = 0,
+               unsigned long minOffMs = 0, uint8_t maxStartsPerHour = 0);
+
+    /**
+     * Queue a state change
+     * @param id Relay id from add()
+     * @param on Requested state
+     * @return millis() time at which the request will take effect
+     */
+    unsigned long request(uint8_t id, bool on);
+
+    /**
+     * Switch a relay OFF immediately, ignoring the minimum ON time
+     * (for safety cut-outs)
+     * @param id Relay id
+     */
+    void forceOff(uint8_t id);
+
+    /**
+     * Drop a queued request
+     * @param id Relay id
+     */
+    void cancel(uint8_t id);
+
+    /**
+     * Check whether a relay has a queued request
+     * @param id Relay id
+     * @return true if a request is waiting
+     */
+    bool isPending(uint8_t id) const;
+
+    /**
+     * When the queued request of a relay will take effect
+     * @param id Relay id
+     * @return millis() time (current time if nothing is queued)
+     */
+    unsigned long effectiveAt(uint8_t id) const;
+
+    /**
+     * Release due requests (call regularly in loop())
+     */
+    void update();
+};
+
+#endif // RELAY_SCHEDULER_H
@@ -0,0 +1,411 @@
+#include "ZeroCrossSync.h"
+
+#define ZC_TIMER_MAX_US 200000UL  // longer waits re-arm on expiry
+#define ZC_LOST_PERIODS 4         // missing crossings before the lock drops
+#define ZC_MAX_REJECTS 8          // consecutive outliers before re-acquiring
+
+// Critical sections shared by loop() code and the two ISRs
+#if defined(ESP32)
+static portMUX_TYPE zcMux = portMUX_INITIALIZER_UNLOCKED;
+static hw_timer_t* zcTimer = NULL;
+#define ZC_ENTER()     portENTER_CRITICAL(&zcMux)
+#define ZC_EXIT()      portEXIT_CRITICAL(&zcMux)
+#define ZC_ENTER_ISR() portENTER_CRITICAL_ISR(&zcMux)
+#define ZC_EXIT_ISR()  portEXIT_CRITICAL_ISR(&zcMux)
+#elif defined(__AVR__)
+#define ZC_ENTER()     uint8_t zcSREG = SREG; cli()
+#define ZC_EXIT()      SREG = zcSREG
+#define ZC_ENTER_ISR() ZC_ENTER()
+#define ZC_EXIT_ISR()  ZC_EXIT()
+#elif defined(ARDUINO)
+#define ZC_ENTER()     noInterrupts()
+#define ZC_EXIT()      interrupts()
+#define ZC_ENTER_ISR() noInterrupts()
+#define ZC_EXIT_ISR()  interrupts()
+#else
+#define ZC_ENTER()
+#define ZC_EXIT()
+#define ZC_ENTER_ISR()
+#define ZC_EXIT_ISR()
+#endif
+
+#ifndef ARDUINO_ISR_ATTR
+#define ARDUINO_ISR_ATTR
+#endif
+
+static ZeroCrossSync* activeSync = NULL;
+
+#if defined(__AVR__)
+// Set by ZeroCrossSyncTimer1.h, which also defines the compare B vector.
+// The vector is not defined here: every library object is linked into the
+// sketch, and it would clash with other Timer1 users (AltSoftSerial, ...)
+// in sketches that never use ZeroCrossSync.
+static bool zcTimer1 = false;
+#endif
+
+ZeroCrossSync::ZeroCrossSync()
+: count(0), zcPin(0), detectorOffset(0), phase(0), periodQ4(0), lockCount(0),
+  rejectCount(0), haveEdge(false), alarmArmed(false), alarmAt(0) {
+}
+
+bool ZeroCrossSync::begin(uint8_t pin, int edge) {
+  if (activeSync != NULL && activeSync != this) {
+    return false;
+  }
+  activeSync = this;
+  zcPin = pin;
+  haveEdge = false;
+  periodQ4 = 0;
+  lockCount = 0;
+  rejectCount = 0;
+  alarmArmed = false;
+
+#if defined(ESP32)
+  zcTimer = timerBegin(1000000);  // 1 MHz, 1 us per tick
+  timerAttachInterrupt(zcTimer, &ZeroCrossSync::timerISR);
+#elif defined(__AVR__)
+  if (zcTimer1) {
+    uint8_t oldSREG = SREG;
+    cli();
+    // Normal mode, clk/64 (4 us per tick at 16 MHz). Only the mode, clock
+    // and compare B output bits are touched, so the DHT library's ICP1
+    // capture (same mode and clock, ICNC1/ICES1 bits) keeps working on the
+    // same timer.
+    TCCR1A &= ~(_BV(COM1B1) | _BV(COM1B0) | _BV(WGM11) | _BV(WGM10));
+    TCCR1B = (TCCR1B & ~(_BV(WGM13) | _BV(WGM12) | _BV(CS12) | _BV(CS11) | _BV(CS10))) |
+             _BV(CS11) | _BV(CS10);
+    TIMSK1 &= ~_BV(OCIE1B);
+    SREG = oldSREG;
+  }
+#endif
+
+#if defined(ARDUINO)
+  pinMode(pin, INPUT);
+  attachInterrupt(digitalPinToInterrupt(pin), &ZeroCrossSync::crossingISR, edge);
+#else
+  (void)edge;
+#endif
+  return true;
+}
+
+void ZeroCrossSync::end() {
+  if (activeSync != this) {
+    return;
+  }
+#if defined(ARDUINO)
+  detachInterrupt(digitalPinToInterrupt(zcPin));
+#endif
+#if defined(ESP32)
+  if (zcTimer) {
+    timerEnd(zcTimer);
+    zcTimer = NULL;
+  }
+#elif defined(__AVR__)
+  if (zcTimer1) {
+    TIMSK1 &= ~_BV(OCIE1B);
+  }
+#endif
+  alarmArmed = false;
+  activeSync = NULL;
+}
+
+int8_t ZeroCrossSync::attach(RelayController& relay, uint16_t operateUs, uint16_t releaseUs) {
+  if (count >= ZC_MAX_RELAYS) {
+    return -1;
+  }
+  Slot& s = slots[count];
+  s.relay = &relay;
+  s.operateUs = operateUs;
+  s.releaseUs = releaseUs;
+  s.fireAt = 0;
+  s.pending = false;
+  s.pendingState = false;
+  return count++;
+}
+
+void ZeroCrossSync::setDelays(uint8_t id, uint16_t operateUs, uint16_t releaseUs) {
+  if (id < count) {
+    slots[id].operateUs = operateUs;
+    slots[id].releaseUs = releaseUs;
+  }
+}
+
+void ZeroCrossSync::setDetectorOffset(int16_t us) {
+  detectorOffset = us;
+}
+
+void ZeroCrossSync::handleCrossing(uint32_t us) {
+  uint32_t c = us + detectorOffset;
+
+  ZC_ENTER_ISR();
+  if (!haveEdge) {
+    phase = c;
+    haveEdge = true;
+  } else if (periodQ4 == 0) {
+    // First interval: accept it if it looks like mains
+    uint32_t interval = c - phase;
+    if (interval >= ZC_MIN_INTERVAL_US && interval <= ZC_MAX_INTERVAL_US) {
+      periodQ4 = interval << 4;
+      lockCount = 1;
+    }
+    phase = c;
+  } else if ((c - phase) > (periodQ4 >> 4) * ZC_LOST_PERIODS + (periodQ4 >> 5)) {
+    // Signal came back after a gap: keep the period, restart the lock
+    phase = c;
+    lockCount = 1;
+  } else {
+    // Match the edge to the nearest predicted crossing
+    uint32_t k = (((c - phase) << 4) + (periodQ4 >> 1)) / periodQ4;
+    if (k == 0) {
+      // Glitch right after a crossing
+      if (++rejectCount >= ZC_MAX_REJECTS) {
+        periodQ4 = 0;
+        lockCount = 0;
+        rejectCount = 0;
+        phase = c;
+      }
+      ZC_EXIT_ISR();
+      return;
+    }
+
+    uint32_t predicted = phase + ((k * periodQ4) >> 4);
+    int32_t err = (int32_t)(c - predicted);
+    int32_t tolerance = (int32_t)(periodQ4 >> 6); // quarter of a period
+
+    if (err > tolerance || err < -tolerance) {
+      // Noise edge: keep the prediction, re-acquire if it persists
+      if (++rejectCount >= ZC_MAX_REJECTS) {
+        periodQ4 = 0;
+        lockCount = 0;
+        rejectCount = 0;
+        phase = c;
+      }
+    } else {
+      // Second-order loop: period gain 1/8, phase gain 1/2
+      periodQ4 += (err * 2) / (int32_t)k;
+      phase = predicted + err / 2;
+      rejectCount = 0;
+      if (lockCount < 255) {
+        lockCount++;
+      }
+      if ((periodQ4 >> 4) < ZC_MIN_INTERVAL_US || (periodQ4 >> 4) > ZC_MAX_INTERVAL_US) {
+        periodQ4 = 0;
+        lockCount = 0;
+      }
+    }
+  }
+  ZC_EXIT_ISR();
+}
+
+bool ZeroCrossSync::lockedAt(uint32_t now) const {
+  if (lockCount < ZC_LOCK_COUNT || periodQ4 == 0) {
+    return false;
+  }
+  // Lost when several crossings in a row were not seen
+  return (int32_t)(now - phase) < (int32_t)((periodQ4 >> 4) * ZC_LOST_PERIODS);
+}
+
+uint32_t ZeroCrossSync::crossingAtOrAfter(uint32_t t) const {
+  int32_t d = (int32_t)(t - phase);
+  if (d <= 0) {
+    return phase;
+  }
+  uint32_t k = (((uint32_t)d << 4) + periodQ4 - 1) / periodQ4;
+  return phase + ((k * periodQ4) >> 4);
+}
+
+uint32_t ZeroCrossSync::nextCrossing(uint32_t us) const {
+  if (periodQ4 == 0) {
+    return us;
+  }
+  uint32_t result;
+  ZC_ENTER();
+  result = crossingAtOrAfter(us);
+  ZC_EXIT();
+  return result;
+}
+
+bool ZeroCrossSync::setState(uint8_t id, bool on) {
+  if (id >= count) {
+    return false;
+  }
+  Slot& s = slots[id];
+  uint32_t now = micros();
+  bool synced;
+
+  ZC_ENTER();
+  synced = lockedAt(now);
+  if (synced) {
+    if (s.relay->isOn() == on) {
+      s.pending = false; // already there, drop an opposite request
+      armEarliest(now);
+      ZC_EXIT();
+      return true;
+    }
+    uint32_t delayUs = on ? s.operateUs : s.releaseUs;
+    uint32_t crossing = crossingAtOrAfter(now + delayUs + ZC_MIN_LEAD_US);
+    s.fireAt = crossing - delayUs;
+    s.pendingState = on;
+    s.pending = true;
+    armEarliest(now);
+  } else {
+    s.pending = false;
+    armEarliest(now);
+  }
+  ZC_EXIT();
+
+  if (!synced) {
+    s.relay->setState(on);
+  }
+  return synced;
+}
+
+bool ZeroCrossSync::isPending(uint8_t id) const {
+  return id < count && slots[id].pending;
+}
+
+bool ZeroCrossSync::isLocked() const {
+  bool locked;
+  uint32_t now = micros();
+  ZC_ENTER();
+  locked = lockedAt(now);
+  ZC_EXIT();
+  return locked;
+}
+
+uint32_t ZeroCrossSync::getCrossingInterval() const {
+  return periodQ4 >> 4;
+}
+
+float ZeroCrossSync::getFrequency() const {
+  uint32_t q = periodQ4;
+  if (q == 0) {
+    return 0.0;
+  }
+  return 16000000.0 / (2.0 * q);
+}
+
+void ZeroCrossSync::update() {
+#if !defined(ESP32)
+#if defined(__AVR__)
+  if (zcTimer1) {
+    return;
+  }
+#endif
+  uint32_t now = micros();
+  if (alarmArmed && (int32_t)(now - alarmAt) >= 0) {
+    handleTimer(now);
+  }
+#endif
+}
+
+void ZeroCrossSync::handleTimer(uint32_t us) {
+  bool fire[ZC_MAX_RELAYS];
+  bool states[ZC_MAX_RELAYS];
+
+  ZC_ENTER_ISR();
+  alarmArmed = false;
+  for (uint8_t i = 0; i < count; i++) {
+    Slot& s = slots[i];
+    fire[i] = s.pending && (int32_t)(us - s.fireAt) >= 0;
+    states[i] = s.pendingState;
+    if (fire[i]) {
+      s.pending = false;
+    }
+  }
+  armEarliest(us);
+  ZC_EXIT_ISR();
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (fire[i]) {
+      slots[i].relay->setState(states[i]);
+    }
+  }
+}
+
+bool ZeroCrossSync::nextAlarm(uint32_t& us) const {
+  us = alarmAt;
+  return alarmArmed;
+}
+
+// Must be called inside a critical section
+void ZeroCrossSync::armEarliest(uint32_t now) {
+  bool any = false;
+  uint32_t earliest = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (slots[i].pending && (!any || (int32_t)(slots[i].fireAt - earliest) < 0)) {
+      earliest = slots[i].fireAt;
+      any = true;
+    }
+  }
+  if (any) {
+    armTimer(now, earliest);
+  } else {
+    alarmArmed = false;
+#if defined(__AVR__)
+    if (zcTimer1) {
+      TIMSK1 &= ~_BV(OCIE1B);
+    }
+#endif
+  }
+}
+
+// Must be called inside a critical section
+void ZeroCrossSync::armTimer(uint32_t now, uint32_t at) {
+  int32_t wait = (int32_t)(at - now);
+  if (wait < 1) {
+    wait = 1;
+  }
+  if ((uint32_t)wait > ZC_TIMER_MAX_US) {
+    wait = ZC_TIMER_MAX_US; // re-armed on expiry
+  }
+  alarmAt = now + wait;
+  alarmArmed = true;
+
+#if defined(ESP32)
+  if (zcTimer) {
+    timerWrite(zcTimer, 0);
+    timerAlarm(zcTimer, wait, false, 0);
+  }
+#elif defined(__AVR__)
+  if (!zcTimer1) {
+    return;
+  }
+  // Round up so the compare never fires before the target
+  uint32_t ticks = ((uint32_t)wait * clockCyclesPerMicrosecond() + 63) / 64;
+  if (ticks < 2) {
+    ticks = 2;
+  }
+  if (ticks > 60000UL) {
+    ticks = 60000UL;
+  }
+  OCR1B = TCNT1 + (uint16_t)ticks;
+  TIFR1 = _BV(OCF1B);
+  TIMSK1 |= _BV(OCIE1B);
+#endif
+}
+
+void ARDUINO_ISR_ATTR ZeroCrossSync::crossingISR() {
+  if (activeSync) {
+    activeSync->handleCrossing(micros());
+  }
+}
+
+void ARDUINO_ISR_ATTR ZeroCrossSync::timerISR() {
+  if (activeSync) {
+    activeSync->handleTimer(micros());
+  }
+}
+
+bool ZeroCrossSync::enableTimer1() {
+#if defined(__AVR__)
+  zcTimer1 = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ZeroCrossSync::timer1Interrupt() {
+  timerISR();
+}
@@ -0,0 +1,188 @@
+#ifndef ZERO_CROSS_SYNC_H
+#define ZERO_CROSS_SYNC_H
+
+#include <Arduino.h>
+#include "RelayController.h"
+
+#define ZC_MAX_RELAYS 4          // relays per synchroniser
+#define ZC_MIN_INTERVAL_US 7000  // accepted detector interval (60 Hz half wave ...
+#define ZC_MAX_INTERVAL_US 21000 // ... to 50 Hz full wave, one pulse per cycle)
+#define ZC_LOCK_COUNT 8          // consistent crossings needed before switching
+#define ZC_MIN_LEAD_US 200       // minimum time to program the timer
+
+/**
+ * ZeroCrossSync
+ * Switches relays and SSRs so their contacts close/open at a mains zero
+ * crossing, which reduces contact arcing, inrush and EMI.
+ *
+ * A zero-cross detector (e.g. H11AA1 or a module with a ZC output) drives an
+ * interrupt pin. The ISR timestamps each crossing and tracks the mains
+ * period and phase with a small phase-locked loop, so jitter and single
+ * glitches are filtered out. A switch request is scheduled so that the
+ * contact moves at the first crossing that is still reachable:
+ *
+ *   fire time = next crossing - operate (or release) delay of the relay
+ *
+ * The coil is then driven from a hardware timer compare interrupt:
+ * - ESP32: a 1 MHz hardware timer (Arduino-ESP32 3.x API)
+ * - AVR: opt-in, #include <ZeroCrossSyncTimer1.h> in the sketch. Timer1
+ *   compare B in normal mode at clk/64 (analogWrite() on pins 9/10 of an UNO
+ *   and the Servo library cannot be used at the same time). The DHT
+ *   library's ICP1 capture (DHT_ICP1.h) uses the same mode and clock and
+ *   can share the timer; neither resets TCNT1 or clears the other's bits.
+ * - Otherwise (AVR without that header, other boards): call update() in
+ *   loop() (polled, as precise as the loop is fast)
+ *
+ * Until the loop has locked (or when the mains signal is lost) requests
+ * switch immediately and setState() returns false.
+ *
+ * Operate/release delays: measure them once per relay type, e.g. with a
+ * scope on coil voltage and contact, or take them from the datasheet
+ * ("operate time", "release time"). Zero-crossing SSRs need 0.
+ *
+ * handleCrossing() and handleTimer() take the time as a parameter and do
+ * not touch hardware, so the synchroniser can be driven on a host with a
+ * simulated 50/60 Hz signal; nextAlarm() tells when the timer would fire
+ * (see extras/test/ZeroCrossSync_test.cpp).
+ */
+class ZeroCrossSync {
+  private:
+    struct Slot {
+      RelayController* relay;
+      uint16_t operateUs;
+      uint16_t releaseUs;
+      uint32_t fireAt;        // micros() time to drive the coil
+      bool pending;
+      bool pendingState;
+    };
+
+    Slot slots[ZC_MAX_RELAYS];
+    uint8_t count;
+    uint8_t zcPin;
+    int16_t detectorOffset;           // crossing = detector edge + offset
+    volatile uint32_t phase;          // time of the last tracked crossing
+    volatile uint32_t periodQ4;       // crossing interval, 1/16 us units
+    volatile uint8_t lockCount;
+    volatile uint8_t rejectCount;
+    volatile bool haveEdge;
+    volatile bool alarmArmed;
+    volatile uint32_t alarmAt;
+
+    bool lockedAt(uint32_t now) const;
+    uint32_t crossingAtOrAfter(uint32_t t) const;
+    void armEarliest(uint32_t now);
+    void armTimer(uint32_t now, uint32_t at);
+
+    static void crossingISR();
+    static void timerISR();
+
+  public:
+    ZeroCrossSync();
+
+    /**
+     * Start tracking the detector and set up the timer (call in setup())
+     * @param pin Zero-cross detector input (must support interrupts)
+     * @param edge Detector edge that marks a crossing (RISING or FALLING)
+     * @return false if another ZeroCrossSync is already running
+     */
+    bool begin(uint8_t pin, int edge = RISING);
+
+    /**
+     * Stop tracking and release the interrupt and timer
+     */
+    void end();
+
+    /**
+     * Add a relay
+     * @param relay Relay to synchronise (call begin() on it first)
+     * @param operateUs Time from coil ON to contact closed (0 for ZC SSRs)
+     * @param releaseUs Time from coil OFF to contact open
+     * @return Relay id for setState(), or -1 if full
+     */
+    int8_t attach(RelayController& relay, uint16_t operateUs = 0, uint16_t releaseUs = 0);
+
+    /**
+     * Change the operate/release delay of a relay
+     */
+    void setDelays(uint8_t id, uint16_t operateUs, uint16_t releaseUs);
+
+    /**
+     * Time from the detector edge to the actual zero crossing
+     * (negative if the detector fires after the crossing)
+     * @param us Offset in microseconds
+     */
+    void setDetectorOffset(int16_t us);
+
+    /**
+     * Switch a relay at the next reachable zero crossing
+     * @param id Relay id from attach()
+     * @param on Requested state
+     * @return true if synchronised, false if switched immediately (not locked)
+     */
+    bool setState(uint8_t id, bool on);
+
+    /**
+     * Check whether a relay has a switch waiting for its crossing
+     */
+    bool isPending(uint8_t id) const;
+
+    /**
+     * Check whether the mains period and phase are being tracked
+     */
+    bool isLocked() const;
+
+    /**
+     * Tracked interval between detected crossings
+     * @return Interval in microseconds (0 until the first measurement)
+     */
+    uint32_t getCrossingInterval() const;
+
+    /**
+     * Mains frequency, assuming one detector pulse per half wave
+     * @return Frequency in Hz (0 until the first measurement)
+     */
+    float getFrequency() const;
+
+    /**
+     * Predicted time of the first crossing at or after a given time
+     * @param us micros() time
+     */
+    uint32_t nextCrossing(uint32_t us) const;
+
+    /**
+     * Poll the schedule on boards without a timer backend (no-op on ESP32,
+     * and on AVR with ZeroCrossSyncTimer1.h, where the timer interrupt does
+     * this)
+     */
+    void update();
+
+    /**
+     * Detector edge at time `us` (called by the pin ISR; call it directly
+     * to feed a simulated signal)
+     */
+    void handleCrossing(uint32_t us);
+
+    /**
+     * Timer expiry at time `us`: drives every due relay and re-arms the
+     * timer (called by the timer ISR; call it directly in a simulation)
+     */
+    void handleTimer(uint32_t us);
+
+    /**
+     * AVR Timer1 backend, called by ZeroCrossSyncTimer1.h: enableTimer1()
+     * before begin() (from a static initialiser), timer1Interrupt() from the
+     * compare B vector
+     * @return false where there is no Timer1 backend
+     */
+    static bool enableTimer1();
+    static void timer1Interrupt();
+
+    /**
+     * When the timer is due to fire next
+     * @param us Receives the micros() time
+     * @return false if the timer is idle
+     */
+    bool nextAlarm(uint32_t& us) const;
+};
+
+#endif // ZERO_CROSS_SYNC_H
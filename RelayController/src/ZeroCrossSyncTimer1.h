@@ -0,0 +1,28 @@
+#ifndef ZERO_CROSS_SYNC_TIMER1_H
+#define ZERO_CROSS_SYNC_TIMER1_H
+
+#include "ZeroCrossSync.h"
+
+/**
+ * ZeroCrossSyncTimer1
+ * Opt-in AVR timer backend for ZeroCrossSync: include this header in the
+ * sketch (in one file only) to drive the coils from the Timer1 compare B
+ * interrupt instead of polling update().
+ *
+ * The vector lives here and not in the library, because Arduino links every
+ * library object into the sketch: sketches that do not include this header
+ * keep TIMER1_COMPB_vect free for AltSoftSerial, FreqMeasure and others.
+ * With it, those libraries cannot be used together with ZeroCrossSync.
+ *
+ * On other boards this header does nothing (ESP32 uses its own timer).
+ */
+
+#if defined(__AVR__) && defined(TIMER1_COMPB_vect)
+ISR(TIMER1_COMPB_vect) {
+  ZeroCrossSync::timer1Interrupt();
+}
+
+static const bool zeroCrossSyncTimer1 = ZeroCrossSync::enableTimer1();
+#endif
+
+#endif // ZERO_CROSS_SYNC_TIMER1_H
@@ -0,0 +1,67 @@
+/*
+ * AdaptiveSampler_MultiSensor
+ *
+ * Two DHT22 sensors, each read only as often as needed: every 2 s while
+ * the temperature moves or is near its fan thresholds, up to every 30 s
+ * while it is stable. The counters show how many reads were saved
+ * compared to a fixed 2 s rate.
+ *
+ * Hardware (ESP32):
+ * - DHT22 #1 DATA → GPIO 4
+ * - DHT22 #2 DATA → GPIO 5
+ *
+ * Required Libraries:
+ * - DHT sensor library by Adafruit
+ * - Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+#include <AdaptiveSampler.h>
+
+const uint8_t SENSOR_COUNT = 2;
+
+TemperatureSensor sensors[SENSOR_COUNT] = {
+  TemperatureSensor(4, DHT22),
+  TemperatureSensor(5, DHT22)
+};
+AdaptiveSampler samplers[SENSOR_COUNT];  // 2 s .. 30 s
+unsigned long reads[SENSOR_COUNT];
+
+void setup() {
+  Serial.begin(115200);
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    sensors[i].begin();
+    sensors[i].setThresholds(30.0, 28.0);  // sample fast near these
+  }
+  Serial.println("=== Adaptive Sampling ===");
+}
+
+void loop() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (samplers[i].isDue() && sensors[i].startRead()) {
+      reads[i]++;
+    }
+    sensors[i].poll();
+
+    if (sensors[i].resultReady()) {
+      samplers[i].update(sensors[i]);
+
+      Serial.print("Sensor ");
+      Serial.print(i + 1);
+      Serial.print(": ");
+      if (sensors[i].isValid()) {
+        Serial.print(sensors[i].getTemperature(), 1);
+        Serial.print(" °C");
+      } else {
+        Serial.print("read failed");
+      }
+      Serial.print("  |  next in ");
+      Serial.print(samplers[i].getInterval() / 1000.0, 1);
+      Serial.print(" s  |  reads: ");
+      Serial.print(reads[i]);
+      Serial.print(" (fixed 2 s: ");
+      Serial.print(millis() / 2000);
+      Serial.println(")");
+    }
+  }
+}
@@ -51,6 +51,8 @@ void loop() {
     Serial.print(" °C  |  Humidity: ");
     Serial.print(humidity, 1);
     Serial.println(" %");
+  } else if (sensor.getStatus() == TemperatureSensor::STATUS_WARMING_UP) {
+    Serial.println("⏳ Sensor warming up...");
   } else {
     Serial.println("❌ Failed to read from DHT11 sensor!");
   }
@@ -0,0 +1,51 @@
+/*
+ * DHT_NonBlocking
+ *
+ * Reads a DHT11 without stalling loop(). The start pulse (20 ms on a
+ * DHT11) is timed by poll() instead of delay(), so the loop counter keeps
+ * running at full speed while a reading is in progress.
+ *
+ * Hardware (ESP32):
+ * - DHT11 DATA → GPIO 4
+ *
+ * Required Libraries:
+ * - DHT sensor library by Adafruit
+ * - Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+
+const int DHT_PIN = 4;
+
+TemperatureSensor sensor(DHT_PIN, DHT11);
+unsigned long loops = 0;
+
+void setup() {
+  Serial.begin(115200);
+  sensor.begin();
+  Serial.println("=== DHT Non-blocking Reading ===");
+}
+
+void loop() {
+  loops++;
+
+  // Starts a new read every 2 s (the call is ignored in between)
+  sensor.startRead();
+  sensor.poll();
+
+  if (sensor.resultReady()) {
+    if (sensor.isValid()) {
+      Serial.print("Temperature: ");
+      Serial.print(sensor.getTemperature(), 1);
+      Serial.print(" °C  |  Humidity: ");
+      Serial.print(sensor.getHumidity(), 1);
+      Serial.print(" %");
+    } else {
+      Serial.print("Read failed");
+    }
+    Serial.print("  |  loop() ran ");
+    Serial.print(loops);
+    Serial.println(" times since the last result");
+    loops = 0;
+  }
+}
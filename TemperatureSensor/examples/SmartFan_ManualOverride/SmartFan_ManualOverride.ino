@@ -112,6 +112,8 @@ void loop() {
     Serial.print(humidity, 1);
     Serial.print(" %  |  Fan: ");
     Serial.println(fanRunning ? "ON" : "OFF");
+  } else if (sensor.getStatus() == TemperatureSensor::STATUS_WARMING_UP) {
+    Serial.println("⏳ Sensor warming up...");
   } else {
     Serial.println("❌ Sensor read error!");
   }
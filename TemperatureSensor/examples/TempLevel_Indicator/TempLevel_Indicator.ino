@@ -15,6 +15,11 @@
  * - COOL: < 28°C → Green LED
  * - WARM: 28-32°C → Yellow LED
  * - HOT: > 32°C → Red LED
+ *
+ * A level only drops back once the temperature is 0.5°C below the
+ * boundary, and is held for at least 30 s, so the LEDs do not flicker
+ * when the temperature sits on a boundary. The LEDs are only switched
+ * when the level changes.
  */
 
 #include <TemperatureSensor.h>
@@ -28,15 +33,21 @@ const int LED_RED_PIN = 16;    // HOT
 const float COOL_MAX = 28.0;   // Below this = COOL
 const float WARM_MAX = 32.0;   // Below this = WARM, above = HOT
 
+// Same boundaries in tenths of °C, 0.5°C hysteresis, 30 s dwell
+const int16_t LEVEL_LIMITS[] = {280, 320};
+BandClassifier<3> levels(LEVEL_LIMITS, 5, 30000);
+
 TemperatureSensor sensor(DHT_PIN, DHT11);
 LEDController ledGreen(LED_GREEN_PIN);
 LEDController ledYellow(LED_YELLOW_PIN);
 LEDController ledRed(LED_RED_PIN);
+bool blinking = false;         // LEDs show the error blink, not the level
 
 void setup() {
   Serial.begin(115200);
   
   sensor.begin();
+  sensor.attachLevels(&levels);
   ledGreen.begin();
   ledYellow.begin();
   ledRed.begin();
@@ -81,12 +92,21 @@ void loop() {
   if (sensor.read()) {
     float temp = sensor.getTemperature();
     float humidity = sensor.getHumidity();
-    
-    TemperatureSensor::TempLevel level = sensor.getTemperatureLevel(COOL_MAX, WARM_MAX);
-    const char* levelStr = sensor.getTemperatureLevelString(COOL_MAX, WARM_MAX);
-    
-    // Update LED indicators
-    updateLEDs(level);
+
+    // Levels follow TempLevel: 0 = COOL, 1 = WARM, 2 = HOT
+    TemperatureSensor::TempLevel level = (TemperatureSensor::TempLevel)sensor.getLevel();
+    const char* levelStr = (level == TemperatureSensor::TEMP_COOL) ? "COOL" :
+                           (level == TemperatureSensor::TEMP_WARM) ? "WARM" : "HOT";
+
+    // Update LED indicators only on a transition (or after an error)
+    if (sensor.levelChanged()) {
+      Serial.print(">>> Level changed to ");
+      Serial.println(levelStr);
+      updateLEDs(level);
+    } else if (blinking) {
+      updateLEDs(level);
+    }
+    blinking = false;
     
     // Display status with emoji
     Serial.print("Status: ");
@@ -103,10 +123,13 @@ void loop() {
     Serial.print(" °C  |  Humidity: ");
     Serial.print(humidity, 1);
     Serial.println(" %");
+  } else if (sensor.getStatus() == TemperatureSensor::STATUS_WARMING_UP) {
+    Serial.println("⏳ Sensor warming up...");
   } else {
     Serial.println("❌ Sensor read error!");
     
     // Blink all LEDs on error
+    blinking = true;
     ledGreen.toggle();
     ledYellow.toggle();
     ledRed.toggle();
@@ -0,0 +1,63 @@
+/*
+ * TemperatureEstimator_Predict
+ *
+ * The DHT22 delivers a value every 2 s, but the control loop below runs
+ * every 100 ms. A Kalman filter tracks temperature and trend, so the loop
+ * works with a prediction for "now" (and 30 s ahead) instead of the last
+ * stale sample, without any extra sensor reads.
+ *
+ * Hardware (ESP32):
+ * - DHT22 DATA → GPIO 4
+ *
+ * Required Libraries:
+ * - DHT sensor library by Adafruit
+ * - Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+#include <TemperatureEstimator.h>
+
+const int DHT_PIN = 4;
+
+TemperatureSensor sensor(DHT_PIN, DHT22);
+TemperatureEstimator estimator(0.2, 0.5); // DHT22 noise, trend change °C/min per min
+
+unsigned long lastControl = 0;
+unsigned long lastPrint = 0;
+
+void setup() {
+  Serial.begin(115200);
+  sensor.begin();
+  Serial.println("=== Temperature Estimator ===");
+}
+
+void loop() {
+  sensor.startRead();
+  sensor.poll();
+  if (sensor.resultReady()) {
+    estimator.update(sensor); // fuse the new sample
+  }
+
+  // 100 ms control loop
+  if (millis() - lastControl >= 100 && estimator.isInitialized()) {
+    lastControl = millis();
+    float now = estimator.getTemperature();
+    float ahead = estimator.getTemperatureAt(millis() + 30000);
+    // ... e.g. start cooling when 'ahead' crosses the limit ...
+    (void)now;
+    (void)ahead;
+  }
+
+  if (millis() - lastPrint >= 1000 && estimator.isInitialized()) {
+    lastPrint = millis();
+    Serial.print("Estimate: ");
+    Serial.print(estimator.getTemperature(), 2);
+    Serial.print(" ± ");
+    Serial.print(estimator.getUncertainty(), 2);
+    Serial.print(" °C  |  Trend: ");
+    Serial.print(estimator.getRate(), 2);
+    Serial.print(" °C/min  |  In 30 s: ");
+    Serial.print(estimator.getTemperatureAt(millis() + 30000), 2);
+    Serial.println(" °C");
+  }
+}
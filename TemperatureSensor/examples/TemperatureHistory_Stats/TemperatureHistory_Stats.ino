@@ -0,0 +1,61 @@
+/*
+ * TemperatureHistory_Stats
+ *
+ * Keeps the last 30 readings (one minute at the DHT's 2 s interval) and
+ * prints mean, min/max, median, EMA and standard deviation. The statistics
+ * are updated as each reading arrives, so asking for them every 100 ms
+ * costs no rescans of the history.
+ *
+ * Hardware (ESP32):
+ * - DHT22 DATA → GPIO 4
+ *
+ * Required Libraries:
+ * - DHT sensor library by Adafruit
+ * - Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+
+const int DHT_PIN = 4;
+
+TemperatureSensor sensor(DHT_PIN, DHT22);
+TemperatureHistory<30> tempHistory;      // last 30 readings
+TemperatureHistory<30> humidityHistory;
+
+unsigned long lastPrint = 0;
+
+void setup() {
+  Serial.begin(115200);
+  sensor.begin();
+  sensor.attachHistory(&tempHistory, &humidityHistory);
+  Serial.println("=== Temperature History ===");
+}
+
+void loop() {
+  sensor.startRead();
+  sensor.poll();
+  sensor.resultReady();
+
+  // A controller could query these every loop; printing every 5 s
+  if (millis() - lastPrint >= 5000 && tempHistory.size() > 0) {
+    lastPrint = millis();
+
+    Serial.print("Samples: ");
+    Serial.print(tempHistory.size());
+    Serial.print("  Mean: ");
+    Serial.print(tempHistory.getMean(), 2);
+    Serial.print(" °C  Min/Max: ");
+    Serial.print(tempHistory.getMin(), 1);
+    Serial.print("/");
+    Serial.print(tempHistory.getMax(), 1);
+    Serial.print("  Median: ");
+    Serial.print(tempHistory.getMedian(), 1);
+    Serial.print("  EMA: ");
+    Serial.print(tempHistory.getEma(), 2);
+    Serial.print("  StdDev: ");
+    Serial.print(tempHistory.getStdDev(), 1);
+    Serial.print("  |  Humidity mean: ");
+    Serial.print(humidityHistory.getMean(), 1);
+    Serial.println(" %");
+  }
+}
@@ -0,0 +1,66 @@
+/*
+ * TemperatureTrend_Alarm
+ *
+ * Early warning from the temperature trend: a least-squares line over the
+ * last 2 minutes raises the alarm when the temperature rises faster than
+ * 2 °C/min or will reach 40 °C within 5 minutes, before the limit itself
+ * is crossed (e.g. a failed fan in a cabinet).
+ *
+ * Hardware (ESP32):
+ * - DHT22 DATA → GPIO 4
+ * - Alarm LED → GPIO 2 (via 220Ω resistor)
+ *
+ * Required Libraries:
+ * - DHT sensor library by Adafruit
+ * - Adafruit Unified Sensor
+ */
+
+#include <TemperatureSensor.h>
+#include <TemperatureTrend.h>
+
+const int DHT_PIN = 4;
+const int ALARM_LED = 2;
+
+const float LIMIT = 40.0;             // °C
+const float MAX_RATE = 2.0;           // °C/min
+const unsigned long LOOK_AHEAD = 300000; // 5 min
+
+TemperatureSensor sensor(DHT_PIN, DHT22);
+TemperatureTrend<64> trend(120000);   // last 2 minutes
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(ALARM_LED, OUTPUT);
+  sensor.begin();
+  Serial.println("=== Temperature Trend Alarm ===");
+}
+
+void loop() {
+  sensor.startRead();
+  sensor.poll();
+  if (!sensor.resultReady() || !trend.update(sensor)) {
+    return;
+  }
+
+  bool alarm = trend.isRisingFasterThan(MAX_RATE) || trend.willExceed(LIMIT, LOOK_AHEAD);
+  digitalWrite(ALARM_LED, alarm ? HIGH : LOW);
+
+  Serial.print("Temperature: ");
+  Serial.print(sensor.getTemperature(), 1);
+  Serial.print(" °C  |  ");
+  if (!trend.isValid()) {
+    Serial.println("collecting trend...");
+    return;
+  }
+  Serial.print("Trend: ");
+  Serial.print(trend.getRate(), 1);
+  Serial.print(" °C/min  |  ");
+  unsigned long eta = trend.timeToReach(LIMIT);
+  if (eta != TREND_NEVER) {
+    Serial.print(LIMIT, 0);
+    Serial.print(" °C in ");
+    Serial.print(eta / 1000);
+    Serial.print(" s  |  ");
+  }
+  Serial.println(alarm ? "⚠️ ALARM" : "OK");
+}
@@ -0,0 +1,96 @@
+#include "AdaptiveSampler.h"
+
+AdaptiveSampler::AdaptiveSampler(unsigned long minIntervalMs, unsigned long maxIntervalMs)
+: minInterval(minIntervalMs), maxInterval(maxIntervalMs < minIntervalMs ? minIntervalMs : maxIntervalMs),
+  noise(2), maxRate(20) {
+  reset();
+}
+
+void AdaptiveSampler::setNoiseDeci(uint8_t deci) {
+  noise = deci;
+}
+
+void AdaptiveSampler::setMaxRateDeci(uint16_t deciPerMinute) {
+  maxRate = deciPerMinute ? deciPerMinute : 1;
+}
+
+void AdaptiveSampler::reset() {
+  interval = minInterval;
+  lastTime = 0;
+  tempTime = 0;
+  nextTime = millis();
+  lastTemp = 0;
+  rate = 0;
+  sampled = false;
+  initialized = false;
+}
+
+bool AdaptiveSampler::update(TemperatureSensor& sensor) {
+  unsigned long t = sensor.getSampleTime();
+  if (sampled && t == lastTime) {
+    return false; // same frame as before
+  }
+  lastTime = t;
+  sampled = true;
+
+  if (!sensor.isValid()) {
+    // Failed read: try again soon, keep the last good reading
+    interval = minInterval;
+    nextTime = t + interval;
+    return true;
+  }
+
+  int16_t temp = sensor.getTemperatureDeci();
+  uint16_t change = 0;
+  if (initialized) {
+    change = abs(temp - lastTemp);
+    unsigned long dt = t - tempTime;
+    rate = (dt > 0) ? min(60000UL * change / dt, 65535UL) : 0;
+  }
+
+  if (!initialized || change > noise) {
+    // Moving: sample fast and measure from this reading on
+    interval = minInterval;
+    lastTemp = temp;
+    tempTime = t;
+  } else {
+    // Within the noise band of the reference reading: slow drifts add up
+    // against it until they count as movement
+    interval = min(interval * 2, maxInterval);
+  }
+
+  // At least two samples before the temperature can reach a threshold
+  int16_t high = sensor.getHighThresholdDeci();
+  int16_t low = sensor.getLowThresholdDeci();
+  uint16_t distance = min(abs(temp - high), abs(temp - low));
+  uint16_t slew = max(rate, maxRate);
+  unsigned long safe = 30000UL * distance / slew;
+  if (interval > safe) {
+    interval = max(safe, minInterval);
+  }
+
+  nextTime = t + interval;
+  initialized = true;
+  return true;
+}
+
+bool AdaptiveSampler::isDue() const {
+  return (long)(millis() - nextTime) >= 0;
+}
+
+unsigned long AdaptiveSampler::msUntilDue() const {
+  long left = (long)(nextTime - millis());
+  return left > 0 ? left : 0;
+}
+
+unsigned long AdaptiveSampler::getNextSampleTime() const {
+  return nextTime;
+}
+
+unsigned long AdaptiveSampler::getInterval() const {
+  return interval;
+}
+
+uint16_t AdaptiveSampler::getRateDeci() const {
+  return rate;
+}
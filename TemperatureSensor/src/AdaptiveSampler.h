@@ -0,0 +1,109 @@
+#ifndef ADAPTIVE_SAMPLER_H
+#define ADAPTIVE_SAMPLER_H
+
+#include <Arduino.h>
+#include "TemperatureSensor.h"
+
+/**
+ * AdaptiveSampler
+ * Decides when a TemperatureSensor should be read next. While the
+ * temperature moves or is close to one of the sensor's thresholds it
+ * samples at the minimum interval (the DHT limit of 2 s); while it is
+ * stable and far from the thresholds the interval doubles with every
+ * sample up to the maximum. Fewer reads mean less bus and CPU time and
+ * less self-heating of the sensor.
+ *
+ * After each sample the next interval is:
+ * - minInterval if the reading moved more than the noise band away from
+ *   the reference reading (the last one that moved), or the read failed
+ * - otherwise twice the previous interval, at most maxInterval
+ * - but never longer than half the time the temperature needs to reach
+ *   the nearest threshold at maxRate (or the observed rate, if faster),
+ *   so there are always at least two samples before a crossing
+ *
+ * Usage:
+ *   AdaptiveSampler sampler;              // 2 s .. 30 s
+ *   if (sampler.isDue()) sensor.startRead();
+ *   sensor.poll();
+ *   if (sensor.resultReady()) sampler.update(sensor);
+ *
+ * Integer only (tenths of °C, milliseconds).
+ */
+class AdaptiveSampler {
+  private:
+    unsigned long minInterval;
+    unsigned long maxInterval;
+    unsigned long interval;     // current interval
+    unsigned long lastTime;     // sensor timestamp of the last sample
+    unsigned long tempTime;     // sensor timestamp of lastTemp
+    unsigned long nextTime;     // planned time of the next sample
+    int16_t lastTemp;           // reference reading, 0.1 °C
+    uint16_t rate;              // observed rate, 0.1 °C per minute
+    uint8_t noise;              // 0.1 °C
+    uint16_t maxRate;           // 0.1 °C per minute
+    bool sampled;               // lastTime is set
+    bool initialized;           // lastTemp is set
+
+  public:
+    /**
+     * Constructor
+     * @param minIntervalMs Interval while the temperature moves (>= 2000 for DHT)
+     * @param maxIntervalMs Longest interval while it is stable
+     */
+    AdaptiveSampler(unsigned long minIntervalMs = 2000, unsigned long maxIntervalMs = 30000);
+
+    /**
+     * Change a reading must exceed to count as movement
+     * @param deci Tenths of °C (default 2; use ~10 for DHT11)
+     */
+    void setNoiseDeci(uint8_t deci);
+
+    /**
+     * Fastest change expected in this room, used to keep a safe distance
+     * to the thresholds
+     * @param deciPerMinute Tenths of °C per minute (default 20 = 2 °C/min)
+     */
+    void setMaxRateDeci(uint16_t deciPerMinute);
+
+    /**
+     * Plan the next sample from the sensor's latest reading
+     * (call after read() / resultReady(); no bus access)
+     * @return true if the reading was new
+     */
+    bool update(TemperatureSensor& sensor);
+
+    /**
+     * Sample immediately (e.g. after a threshold or setpoint change)
+     */
+    void reset();
+
+    /**
+     * Check whether the next sample is due
+     */
+    bool isDue() const;
+
+    /**
+     * Time left until the next sample
+     * @return Milliseconds (0 = due)
+     */
+    unsigned long msUntilDue() const;
+
+    /**
+     * millis() time of the next planned sample
+     */
+    unsigned long getNextSampleTime() const;
+
+    /**
+     * Current sampling interval
+     * @return Milliseconds
+     */
+    unsigned long getInterval() const;
+
+    /**
+     * Rate of change since the reference reading
+     * @return Tenths of °C per minute (absolute)
+     */
+    uint16_t getRateDeci() const;
+};
+
+#endif // ADAPTIVE_SAMPLER_H
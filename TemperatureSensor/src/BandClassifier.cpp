@@ -0,0 +1,64 @@
+#include "BandClassifier.h"
+#include <DHT.h>
+
+BandClassifierBase::BandClassifierBase(int16_t* boundBuf, uint8_t* hystBuf, uint8_t count)
+: bounds(boundBuf), hysteresis(hystBuf), bands(count), minDwell(0) {
+  reset();
+}
+
+void BandClassifierBase::reset() {
+  level = BAND_UNKNOWN;
+  previous = BAND_UNKNOWN;
+  changedAt = 0;
+}
+
+void BandClassifierBase::setBoundary(uint8_t index, int16_t deci, uint8_t hystDeci) {
+  if (index < bands - 1) {
+    bounds[index] = deci;
+    hysteresis[index] = hystDeci;
+  }
+}
+
+void BandClassifierBase::setBoundaries(const int16_t* deci, uint8_t hystDeci) {
+  for (uint8_t i = 0; i < bands - 1; i++) {
+    setBoundary(i, deci[i], hystDeci);
+  }
+}
+
+void BandClassifierBase::setMinDwell(unsigned long ms) {
+  minDwell = ms;
+}
+
+bool BandClassifierBase::update(int16_t value, unsigned long timeMs) {
+  if (value == DHT_INVALID_DECI) {
+    return false; // hold the level on a failed read
+  }
+
+  uint8_t target;
+  if (level == BAND_UNKNOWN) {
+    // First sample: plain thresholds
+    target = 0;
+    while (target < bands - 1 && value >= bounds[target]) {
+      target++;
+    }
+  } else {
+    if (timeMs - changedAt < minDwell) {
+      return false; // still within the dwell time
+    }
+    target = level;
+    while (target < bands - 1 && value >= bounds[target]) {
+      target++;
+    }
+    while (target > 0 && value < bounds[target - 1] - hysteresis[target - 1]) {
+      target--;
+    }
+    if (target == level) {
+      return false;
+    }
+  }
+
+  previous = level;
+  level = target;
+  changedAt = timeMs;
+  return true;
+}
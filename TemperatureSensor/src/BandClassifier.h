@@ -0,0 +1,139 @@
+#ifndef BAND_CLASSIFIER_H
+#define BAND_CLASSIFIER_H
+
+#include <Arduino.h>
+
+#define BAND_UNKNOWN 0xFF  // getLevel() before the first valid sample
+
+/**
+ * BandClassifierBase
+ * Sorts samples into N bands (levels 0..N-1, ascending) with hysteresis
+ * per boundary and a minimum dwell time, so readings near a boundary do
+ * not make the level - and the relays and LEDs driven from it - chatter.
+ * Declare a BandClassifier<N> instead; this base holds the code for all N.
+ *
+ * Boundary i separates level i from level i+1:
+ * - the level rises past it when the value is >= boundary
+ * - it falls back below it only when the value is < boundary - hysteresis
+ * - after a change the level is held for at least the dwell time
+ *
+ * Event driven: update() is called once per new sample and returns true
+ * only when the level changes, so downstream code runs on transitions
+ * instead of on every reading. Values are in tenths (0.1 °C).
+ */
+class BandClassifierBase {
+  private:
+    int16_t* bounds;          // N-1 boundaries, ascending, 0.1 °C
+    uint8_t* hysteresis;      // per boundary, 0.1 °C
+    uint8_t bands;
+    uint8_t level;
+    uint8_t previous;
+    unsigned long minDwell;   // ms
+    unsigned long changedAt;  // millis() of the last change
+
+  protected:
+    BandClassifierBase(int16_t* boundBuf, uint8_t* hystBuf, uint8_t count);
+
+  public:
+    /**
+     * Classify a new sample
+     * @param value Value in tenths; DHT_INVALID_DECI is ignored
+     * @param timeMs millis() of the sample (for the dwell time)
+     * @return true if the level changed (also for the first sample)
+     */
+    bool update(int16_t value, unsigned long timeMs);
+    bool update(int16_t value) { return update(value, millis()); }
+
+    /**
+     * Set one boundary
+     * @param index 0 = between level 0 and 1, ...
+     * @param deci Boundary in tenths (keep them ascending)
+     * @param hystDeci Hysteresis below the boundary, in tenths
+     */
+    void setBoundary(uint8_t index, int16_t deci, uint8_t hystDeci);
+
+    /**
+     * Set all boundaries with the same hysteresis
+     * @param deci Array of getBands() - 1 ascending boundaries in tenths
+     * @param hystDeci Hysteresis in tenths
+     */
+    void setBoundaries(const int16_t* deci, uint8_t hystDeci);
+
+    /**
+     * Minimum time between two level changes
+     * @param ms e.g. 60000 to switch a relay at most once a minute
+     */
+    void setMinDwell(unsigned long ms);
+
+    /**
+     * Forget the level (the next sample is classified without hysteresis)
+     */
+    void reset();
+
+    /**
+     * Current level
+     * @return 0..getBands()-1, or BAND_UNKNOWN before the first sample
+     */
+    uint8_t getLevel() const { return level; }
+
+    /**
+     * Level before the last change
+     * @return 0..getBands()-1, or BAND_UNKNOWN
+     */
+    uint8_t getPreviousLevel() const { return previous; }
+
+    /**
+     * Time of the last level change
+     * @return millis()
+     */
+    unsigned long getChangeTime() const { return changedAt; }
+
+    uint8_t getBands() const { return bands; }
+};
+
+/**
+ * BandClassifier
+ * N-band classifier; boundaries at compile time or at runtime.
+ *
+ * Usage:
+ *   const int16_t LIMITS[] = {280, 320};        // COOL | WARM | HOT
+ *   BandClassifier<3> levels(LIMITS, 5);         // 0.5 °C hysteresis
+ *   ...
+ *   if (levels.update(sensor.getTemperatureDeci())) {
+ *     switchOutputs(levels.getLevel());          // only on transitions
+ *   }
+ */
+template <uint8_t N>
+class BandClassifier : public BandClassifierBase {
+  private:
+    int16_t boundBuf[N - 1];
+    uint8_t hystBuf[N - 1];
+
+  public:
+    /**
+     * Constructor, boundaries set later with setBoundary()
+     */
+    BandClassifier()
+    : BandClassifierBase(boundBuf, hystBuf, N) {
+      static_assert(N >= 2 && N < BAND_UNKNOWN, "BandClassifier needs 2..254 bands");
+      for (uint8_t i = 0; i < N - 1; i++) {
+        boundBuf[i] = 0;
+        hystBuf[i] = 0;
+      }
+    }
+
+    /**
+     * Constructor
+     * @param deci N-1 ascending boundaries in tenths
+     * @param hystDeci Hysteresis for every boundary, in tenths
+     * @param dwellMs Minimum time between level changes
+     */
+    BandClassifier(const int16_t (&deci)[N - 1], uint8_t hystDeci, unsigned long dwellMs = 0)
+    : BandClassifierBase(boundBuf, hystBuf, N) {
+      static_assert(N >= 2 && N < BAND_UNKNOWN, "BandClassifier needs 2..254 bands");
+      setBoundaries(deci, hystDeci);
+      setMinDwell(dwellMs);
+    }
+};
+
+#endif // BAND_CLASSIFIER_H
@@ -0,0 +1,126 @@
+#include "TemperatureEstimator.h"
+
+#define ESTIMATOR_GATE 25.0f        // outlier gate: 5 sigma, squared
+#define ESTIMATOR_MAX_REJECTS 3     // outliers in a row before a restart
+#define ESTIMATOR_RATE_VAR 0.0001f  // initial rate variance: (0.01 °C/s)²
+
+TemperatureEstimator::TemperatureEstimator(float noise, float rateChange) {
+  setNoise(noise, rateChange);
+  reset();
+}
+
+void TemperatureEstimator::setNoise(float noise, float rateChange) {
+  r = noise * noise;
+  // rateChange °C/min per minute -> rate variance growth per second
+  float perSecond = rateChange / 60.0f;
+  q = perSecond * perSecond / 60.0f;
+}
+
+void TemperatureEstimator::reset() {
+  temp = 0;
+  rate = 0;
+  p00 = p01 = p11 = 0;
+  lastTime = 0;
+  lastSampleTime = 0;
+  initialized = false;
+  rejected = 0;
+}
+
+bool TemperatureEstimator::isInitialized() const {
+  return initialized;
+}
+
+// Move the state dt seconds along the model
+void TemperatureEstimator::predict(float dt) {
+  temp += rate * dt;
+  float dt2 = dt * dt;
+  p00 += dt * (2.0f * p01 + dt * p11) + q * dt2 * dt / 3.0f;
+  p01 += dt * p11 + q * dt2 / 2.0f;
+  p11 += q * dt;
+}
+
+bool TemperatureEstimator::update(TemperatureSensor& sensor) {
+  if (!sensor.isValid()) {
+    return false;
+  }
+  unsigned long t = sensor.getSampleTime();
+  if (initialized && t == lastSampleTime) {
+    return false; // already fused
+  }
+  lastSampleTime = t;
+  return addMeasurement(sensor.getTemperature(), t);
+}
+
+bool TemperatureEstimator::addMeasurement(float temperature, unsigned long timeMs) {
+  if (!initialized) {
+    temp = temperature;
+    rate = 0;
+    p00 = r;
+    p01 = 0;
+    p11 = ESTIMATOR_RATE_VAR;
+    lastTime = timeMs;
+    initialized = true;
+    rejected = 0;
+    return true;
+  }
+
+  float dt = (long)(timeMs - lastTime) / 1000.0f;
+  if (dt > 0) {
+    predict(dt);
+    lastTime = timeMs;
+  }
+
+  float s = p00 + r;
+  float y = temperature - temp;
+  if (y * y > ESTIMATOR_GATE * s) {
+    if (++rejected >= ESTIMATOR_MAX_REJECTS) {
+      // Not a glitch: the temperature really changed, start over
+      initialized = false;
+      addMeasurement(temperature, timeMs);
+      return true;
+    }
+    return false;
+  }
+  rejected = 0;
+
+  float k0 = p00 / s;
+  float k1 = p01 / s;
+  temp += k0 * y;
+  rate += k1 * y;
+  p11 -= k1 * p01;
+  p01 -= k0 * p01;
+  p00 -= k0 * p00;
+  return true;
+}
+
+float TemperatureEstimator::getTemperature() const {
+  return getTemperatureAt(millis());
+}
+
+float TemperatureEstimator::getTemperatureAt(unsigned long timeMs) const {
+  if (!initialized) {
+    return NAN;
+  }
+  float dt = (long)(timeMs - lastTime) / 1000.0f;
+  return temp + rate * dt;
+}
+
+float TemperatureEstimator::getRate() const {
+  return rate * 60.0f;
+}
+
+float TemperatureEstimator::getUncertainty() const {
+  return getUncertaintyAt(millis());
+}
+
+float TemperatureEstimator::getUncertaintyAt(unsigned long timeMs) const {
+  if (!initialized) {
+    return NAN;
+  }
+  float dt = (long)(timeMs - lastTime) / 1000.0f;
+  if (dt < 0) {
+    dt = 0;
+  }
+  float var = p00 + dt * (2.0f * p01 + dt * p11) + q * dt * dt * dt / 3.0f;
+  return sqrt(var);
+}
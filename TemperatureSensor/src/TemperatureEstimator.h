@@ -0,0 +1,111 @@
+#ifndef TEMPERATURE_ESTIMATOR_H
+#define TEMPERATURE_ESTIMATOR_H
+
+#include <Arduino.h>
+#include "TemperatureSensor.h"
+
+/**
+ * TemperatureEstimator
+ * Kalman filter that tracks temperature and its rate of change from the
+ * sparse DHT samples (one every 2 s or more), so a control loop running
+ * every 100 ms can use a predicted value instead of the last stale one.
+ *
+ * Model: constant velocity, state = [temperature, rate]. Between samples
+ * the temperature moves along the rate, and the uncertainty grows; each
+ * sample pulls the estimate back according to the measurement noise.
+ * - getTemperature() / getTemperatureAt(): prediction for any instant,
+ *   computed from the state without touching the sensor
+ * - getUncertainty(): 1-sigma confidence of that prediction
+ *
+ * A sample is fused only once (by its sensor timestamp). Samples more than
+ * 5 sigma away from the prediction are ignored as glitches; three in a row
+ * restart the filter (the temperature really jumped).
+ *
+ * Cost: about 30 float operations per sample and 10 per prediction, fine
+ * on an AVR at these rates.
+ */
+class TemperatureEstimator {
+  private:
+    float temp;           // °C at lastTime
+    float rate;           // °C/s
+    float p00, p01, p11;  // covariance of (temp, rate)
+    float r;              // measurement variance, °C²
+    float q;              // rate random walk, °C²/s³
+    unsigned long lastTime;       // time of the state
+    unsigned long lastSampleTime; // sensor timestamp already fused
+    bool initialized;
+    uint8_t rejected;     // consecutive outliers
+
+    void predict(float dt);
+
+  public:
+    /**
+     * Constructor
+     * @param noise Measurement noise (1 sigma, °C): ~0.2 for DHT22, ~0.5 for DHT11
+     * @param rateChange How quickly the trend may change, °C/min per minute
+     */
+    TemperatureEstimator(float noise = 0.2, float rateChange = 0.5);
+
+    /**
+     * Fuse the sensor's latest reading if it is new and valid
+     * (call after read() / resultReady(); no bus access)
+     * @return true if a new sample was fused
+     */
+    bool update(TemperatureSensor& sensor);
+
+    /**
+     * Fuse a measurement
+     * @param temperature Measured °C
+     * @param timeMs millis() when it was measured
+     * @return false if it was rejected as an outlier
+     */
+    bool addMeasurement(float temperature, unsigned long timeMs);
+
+    /**
+     * Forget the state (the next sample starts over)
+     */
+    void reset();
+
+    /**
+     * Change the filter tuning (see constructor)
+     */
+    void setNoise(float noise, float rateChange);
+
+    /**
+     * Check whether at least one sample was fused
+     */
+    bool isInitialized() const;
+
+    /**
+     * Predicted temperature now
+     * @return °C (NAN before the first sample)
+     */
+    float getTemperature() const;
+
+    /**
+     * Predicted temperature at a given time (past or future)
+     * @param timeMs millis() time, e.g. millis() + 30000 to look ahead
+     * @return °C (NAN before the first sample)
+     */
+    float getTemperatureAt(unsigned long timeMs) const;
+
+    /**
+     * Estimated rate of change
+     * @return °C per minute
+     */
+    float getRate() const;
+
+    /**
+     * Confidence of the prediction now
+     * @return 1-sigma uncertainty in °C (NAN before the first sample)
+     */
+    float getUncertainty() const;
+
+    /**
+     * Confidence of the prediction at a given time
+     * @return 1-sigma uncertainty in °C (NAN before the first sample)
+     */
+    float getUncertaintyAt(unsigned long timeMs) const;
+};
+
+#endif // TEMPERATURE_ESTIMATOR_H
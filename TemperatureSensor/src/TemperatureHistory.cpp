@@ -0,0 +1,239 @@
+#include "TemperatureHistory.h"
+
+TemperatureHistoryBase::TemperatureHistoryBase(int16_t* valueBuf, uint8_t* indexBuf, uint8_t size, uint8_t shift)
+: values(valueBuf), lo(indexBuf), hi(indexBuf + size), heapPos(indexBuf + 2 * size),
+  inLo(indexBuf + 3 * size), maxQ(indexBuf + 4 * size), minQ(indexBuf + 5 * size),
+  capacity(size), emaShift(shift) {
+  clear();
+}
+
+void TemperatureHistoryBase::clear() {
+  count = 0;
+  next = 0;
+  loSize = hiSize = 0;
+  maxHead = maxLen = minHead = minLen = 0;
+  sum = 0;
+  sumSq = 0;
+  ema = 0;
+  emaValid = false;
+}
+
+void TemperatureHistoryBase::setEmaShift(uint8_t shift) {
+  emaShift = shift;
+  emaValid = (count > 0);
+  if (emaValid) {
+    ema = (int32_t)getLastDeci() << 8;
+  }
+}
+
+// ---- Heaps of ring positions, ordered by value ----
+
+bool TemperatureHistoryBase::above(uint8_t a, uint8_t b, bool maxHeap) const {
+  return maxHeap ? (values[a] > values[b]) : (values[a] < values[b]);
+}
+
+void TemperatureHistoryBase::heapSet(uint8_t* heap, uint8_t i, uint8_t slot) {
+  heap[i] = slot;
+  heapPos[slot] = i;
+}
+
+void TemperatureHistoryBase::siftUp(uint8_t* heap, uint8_t i, bool maxHeap) {
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!above(heap[i], heap[parent], maxHeap)) {
+      break;
+    }
+    uint8_t slot = heap[i];
+    heapSet(heap, i, heap[parent]);
+    heapSet(heap, parent, slot);
+    i = parent;
+  }
+}
+
+void TemperatureHistoryBase::siftDown(uint8_t* heap, uint8_t size, uint8_t i, bool maxHeap) {
+  while (true) {
+    uint16_t child = 2 * (uint16_t)i + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && above(heap[child + 1], heap[child], maxHeap)) {
+      child++;
+    }
+    if (!above(heap[child], heap[i], maxHeap)) {
+      break;
+    }
+    uint8_t slot = heap[i];
+    heapSet(heap, i, heap[child]);
+    heapSet(heap, child, slot);
+    i = child;
+  }
+}
+
+void TemperatureHistoryBase::heapPush(bool toLo, uint8_t slot) {
+  uint8_t* heap = toLo ? lo : hi;
+  uint8_t& size = toLo ? loSize : hiSize;
+  inLo[slot] = toLo;
+  heapSet(heap, size, slot);
+  size++;
+  siftUp(heap, size - 1, toLo);
+}
+
+uint8_t TemperatureHistoryBase::heapPop(bool fromLo) {
+  uint8_t* heap = fromLo ? lo : hi;
+  uint8_t& size = fromLo ? loSize : hiSize;
+  uint8_t top = heap[0];
+  size--;
+  if (size > 0) {
+    heapSet(heap, 0, heap[size]);
+    siftDown(heap, size, 0, fromLo);
+  }
+  return top;
+}
+
+// lo holds the lower half and may be one larger than hi
+void TemperatureHistoryBase::rebalance() {
+  if (loSize > hiSize + 1) {
+    heapPush(false, heapPop(true));
+  } else if (hiSize > loSize) {
+    heapPush(true, heapPop(false));
+  }
+}
+
+// ---- Monotonic queues for min/max ----
+
+void TemperatureHistoryBase::queuePush(uint8_t* q, uint8_t head, uint8_t& len, uint8_t slot, bool forMax) {
+  int16_t v = values[slot];
+  while (len > 0) {
+    int16_t back = values[q[(head + len - 1) % capacity]];
+    if (forMax ? (back > v) : (back < v)) {
+      break;
+    }
+    len--; // can never be the max (min) while the new sample is in the window
+  }
+  q[(head + len) % capacity] = slot;
+  len++;
+}
+
+void TemperatureHistoryBase::add(int16_t value) {
+  uint8_t slot = next;
+
+  if (count == capacity) {
+    // The oldest sample leaves the window: it is at the front of a queue
+    // if it is still the min/max, and its heap node is reused in place
+    if (maxLen > 0 && maxQ[maxHead] == slot) {
+      maxHead = (maxHead + 1) % capacity;
+      maxLen--;
+    }
+    if (minLen > 0 && minQ[minHead] == slot) {
+      minHead = (minHead + 1) % capacity;
+      minLen--;
+    }
+    int16_t old = values[slot];
+    sum -= old;
+    sumSq -= (int32_t)old * old;
+
+    values[slot] = value;
+    bool maxHeap = inLo[slot];
+    uint8_t* heap = maxHeap ? lo : hi;
+    siftUp(heap, heapPos[slot], maxHeap);
+    siftDown(heap, maxHeap ? loSize : hiSize, heapPos[slot], maxHeap);
+
+    // The new value may belong to the other half: swap the two tops
+    if (loSize > 0 && hiSize > 0 && values[lo[0]] > values[hi[0]]) {
+      uint8_t a = lo[0];
+      uint8_t b = hi[0];
+      heapSet(lo, 0, b);
+      inLo[b] = 1;
+      heapSet(hi, 0, a);
+      inLo[a] = 0;
+      siftDown(lo, loSize, 0, true);
+      siftDown(hi, hiSize, 0, false);
+    }
+  } else {
+    values[slot] = value;
+    count++;
+    heapPush(loSize == 0 || value <= values[lo[0]], slot);
+    rebalance();
+  }
+
+  sum += value;
+  sumSq += (int32_t)value * value;
+  queuePush(maxQ, maxHead, maxLen, slot, true);
+  queuePush(minQ, minHead, minLen, slot, false);
+
+  if (emaValid) {
+    ema += (((int32_t)value << 8) - ema) >> emaShift;
+  } else {
+    ema = (int32_t)value << 8;
+    emaValid = true;
+  }
+
+  next = (next + 1 == capacity) ? 0 : next + 1;
+}
+
+// ---- Queries ----
+
+int16_t TemperatureHistoryBase::getLastDeci() const {
+  if (count == 0) {
+    return 0;
+  }
+  return values[(next == 0) ? capacity - 1 : next - 1];
+}
+
+int16_t TemperatureHistoryBase::getMeanDeci() const {
+  if (count == 0) {
+    return 0;
+  }
+  int32_t half = count / 2;
+  return (int16_t)((sum >= 0 ? sum + half : sum - half) / count);
+}
+
+int16_t TemperatureHistoryBase::getMinDeci() const {
+  return (minLen > 0) ? values[minQ[minHead]] : 0;
+}
+
+int16_t TemperatureHistoryBase::getMaxDeci() const {
+  return (maxLen > 0) ? values[maxQ[maxHead]] : 0;
+}
+
+int16_t TemperatureHistoryBase::getMedianDeci() const {
+  if (count == 0) {
+    return 0;
+  }
+  if (loSize > hiSize) {
+    return values[lo[0]];
+  }
+  return (int16_t)(((int32_t)values[lo[0]] + values[hi[0]]) / 2);
+}
+
+int16_t TemperatureHistoryBase::getEmaDeci() const {
+  return (int16_t)((ema + 128) >> 8);
+}
+
+uint32_t TemperatureHistoryBase::getVariance() const {
+  if (count == 0) {
+    return 0;
+  }
+  int64_t n = count;
+  return (uint32_t)((n * sumSq - (int64_t)sum * sum) / (n * n));
+}
+
+int16_t TemperatureHistoryBase::getStdDevDeci() const {
+  // Integer square root, one result bit per step
+  uint32_t v = getVariance();
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > v) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (v >= root + bit) {
+      v -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (int16_t)root;
+}
@@ -0,0 +1,137 @@
+#ifndef TEMPERATURE_HISTORY_H
+#define TEMPERATURE_HISTORY_H
+
+#include <Arduino.h>
+
+/**
+ * TemperatureHistoryBase
+ * Rolling statistics over the last N samples (in tenths, as returned by
+ * the *Deci() methods of TemperatureSensor). Declare a TemperatureHistory<N>
+ * instead; this base holds the code so it is compiled only once for all N.
+ *
+ * Every statistic is updated as the sample arrives, so queries are O(1)
+ * (the standard deviation is an integer square root of the variance):
+ * - Mean and variance: running sum and sum of squares
+ * - EMA: fixed point, alpha = 1 / 2^emaShift
+ * - Min and max: monotonic queues of ring positions; each sample is pushed
+ *   and popped at most once
+ * - Median: two heaps (lower half max-heap, upper half min-heap). Once the
+ *   window is full the new sample replaces the oldest one in place, which
+ *   is re-sifted in its heap: O(log N) per sample.
+ */
+class TemperatureHistoryBase {
+  private:
+    int16_t* values;      // ring buffer
+    uint8_t* lo;          // max-heap of ring positions (lower half)
+    uint8_t* hi;          // min-heap of ring positions (upper half)
+    uint8_t* heapPos;     // index of each ring position in lo or hi
+    uint8_t* inLo;        // 1 if the ring position is in lo
+    uint8_t* maxQ;        // ring positions with decreasing values
+    uint8_t* minQ;        // ring positions with increasing values
+    uint8_t capacity;
+    uint8_t count;
+    uint8_t next;         // ring position of the next sample
+    uint8_t loSize, hiSize;
+    uint8_t maxHead, maxLen, minHead, minLen;
+    uint8_t emaShift;
+    int32_t sum;
+    int64_t sumSq;
+    int32_t ema;          // tenths << 8
+    bool emaValid;
+
+    bool above(uint8_t a, uint8_t b, bool maxHeap) const;
+    void heapSet(uint8_t* heap, uint8_t i, uint8_t slot);
+    void siftUp(uint8_t* heap, uint8_t i, bool maxHeap);
+    void siftDown(uint8_t* heap, uint8_t size, uint8_t i, bool maxHeap);
+    void heapPush(bool toLo, uint8_t slot);
+    uint8_t heapPop(bool fromLo);
+    void rebalance();
+    void queuePush(uint8_t* q, uint8_t head, uint8_t& len, uint8_t slot, bool forMax);
+
+  protected:
+    TemperatureHistoryBase(int16_t* valueBuf, uint8_t* indexBuf, uint8_t size, uint8_t shift);
+
+  public:
+    /**
+     * Add a sample (called by TemperatureSensor for every valid reading)
+     * @param value Value in tenths
+     */
+    void add(int16_t value);
+
+    /**
+     * Forget all samples
+     */
+    void clear();
+
+    /**
+     * Set the EMA smoothing, alpha = 1 / 2^shift (restarts the EMA)
+     * @param shift 0-8, e.g. 3 = 1/8
+     */
+    void setEmaShift(uint8_t shift);
+
+    uint8_t size() const { return count; }
+    uint8_t getCapacity() const { return capacity; }
+    bool isFull() const { return count == capacity; }
+
+    /**
+     * Latest sample
+     * @return Value in tenths (0 if empty)
+     */
+    int16_t getLastDeci() const;
+
+    /**
+     * Statistics of the samples in the window, in tenths (0 if empty)
+     */
+    int16_t getMeanDeci() const;
+    int16_t getMinDeci() const;
+    int16_t getMaxDeci() const;
+    int16_t getMedianDeci() const;
+    int16_t getEmaDeci() const;
+    int16_t getStdDevDeci() const;
+
+    /**
+     * Population variance of the window
+     * @return Variance in hundredths (0.01 °C²)
+     */
+    uint32_t getVariance() const;
+
+    /**
+     * Same statistics as float in whole units (°C or %RH)
+     */
+    float getMean() const { return count ? sum / (10.0 * count) : 0; }
+    float getMin() const { return getMinDeci() * 0.1; }
+    float getMax() const { return getMaxDeci() * 0.1; }
+    float getMedian() const { return getMedianDeci() * 0.1; }
+    float getEma() const { return ema / 2560.0; }
+    float getStdDev() const { return getStdDevDeci() * 0.1; }
+};
+
+/**
+ * TemperatureHistory
+ * Fixed-size window of the last N samples with O(1) statistics.
+ * Memory: 8 bytes per sample.
+ *
+ * Usage:
+ *   TemperatureHistory<30> tempHistory;   // last 30 readings
+ *   sensor.attachHistory(&tempHistory);
+ *   ...
+ *   tempHistory.getMean(); tempHistory.getMax(); tempHistory.getMedian();
+ */
+template <uint8_t N>
+class TemperatureHistory : public TemperatureHistoryBase {
+  private:
+    int16_t valueBuf[N];
+    uint8_t indexBuf[6 * N];
+
+  public:
+    /**
+     * Constructor
+     * @param emaShift EMA smoothing, alpha = 1 / 2^emaShift (default 1/8)
+     */
+    TemperatureHistory(uint8_t emaShift = 3)
+    : TemperatureHistoryBase(valueBuf, indexBuf, N, emaShift) {
+      static_assert(N > 0, "TemperatureHistory needs at least one sample");
+    }
+};
+
+#endif // TEMPERATURE_HISTORY_H
@@ -1,8 +1,11 @@
 #include "TemperatureSensor.h"
 
-TemperatureSensor::TemperatureSensor(uint8_t dhtPin, uint8_t dhtType)
-: pin(dhtPin), type(dhtType), lastTemp(0), lastHumidity(0), lastReadValid(false), tempHigh(30.0), tempLow(28.0) {
-  dht = new DHT(pin, type);
+TemperatureSensor::TemperatureSensor(uint8_t dhtPin, uint8_t dhtType, DHTCapture capture)
+: pin(dhtPin), type(dhtType), lastTemp(0), lastHumidity(0), lastReadValid(false), newResult(false),
+  status(STATUS_WARMING_UP), begun(false), warm(false), readyAt(0), tempHigh(300), tempLow(280),
+  tempHistory(nullptr), humidityHistory(nullptr), historyFed(false), historyTime(0), sampleTime(0),
+  levels(nullptr), levelEvent(false) {
+  dht = new DHT(pin, type, 6, capture);
 }
 
 TemperatureSensor::~TemperatureSensor() {
@@ -11,31 +14,150 @@ TemperatureSensor::~TemperatureSensor() {
 
 void TemperatureSensor::begin() {
   dht->begin();
-  delay(2000); // DHT sensors need time to stabilize
+  // DHT sensors need time to stabilize; no delay(), just a deadline
+  begun = true;
+  warm = false;
+  readyAt = millis() + TEMP_SENSOR_WARMUP_MS;
+  status = STATUS_WARMING_UP;
+}
+
+bool TemperatureSensor::isReady() {
+  if (!warm && begun && (long)(millis() - readyAt) >= 0) {
+    warm = true;
+  }
+  return warm;
+}
+
+unsigned long TemperatureSensor::msUntilReady() {
+  if (isReady()) {
+    return 0;
+  }
+  if (!begun) {
+    return TEMP_SENSOR_WARMUP_MS;
+  }
+  return readyAt - millis();
+}
+
+TemperatureSensor::Status TemperatureSensor::getStatus() const {
+  return status;
+}
+
+// Round to tenths (thresholds and limits given as float)
+int16_t TemperatureSensor::toDeci(float value) {
+  return (int16_t)(value * 10.0f + (value < 0 ? -0.5f : 0.5f));
 }
 
 bool TemperatureSensor::read() {
-  lastHumidity = dht->readHumidity();
-  lastTemp = dht->readTemperature();
+  if (!isReady()) {
+    lastReadValid = false;
+    status = STATUS_WARMING_UP;
+    return false;
+  }
+
+  // Both values from one frame (one bus transaction at most)
+  DHTSample sample;
+  dht->readSample(sample);
+  lastTemp = sample.temperature;
+  lastHumidity = sample.humidity;
+  sampleTime = sample.timestamp;
   
-  if (isnan(lastHumidity) || isnan(lastTemp)) {
+  if (sample.status != DHT_OK) {
     lastReadValid = false;
+    status = STATUS_ERROR;
     return false;
   }
   
   lastReadValid = true;
+  status = STATUS_OK;
+
+  // Only new frames, not the DHT's cached copy of the last one
+  if (!historyFed || sampleTime != historyTime) {
+    historyFed = true;
+    historyTime = sampleTime;
+    if (tempHistory) {
+      tempHistory->add(lastTemp);
+    }
+    if (humidityHistory) {
+      humidityHistory->add(lastHumidity);
+    }
+    if (levels && levels->update(lastTemp, sampleTime)) {
+      levelEvent = true;
+    }
+  }
+  return true;
+}
+
+void TemperatureSensor::attachHistory(TemperatureHistoryBase* temperature, TemperatureHistoryBase* humidity) {
+  tempHistory = temperature;
+  humidityHistory = humidity;
+}
+
+void TemperatureSensor::attachLevels(BandClassifierBase* classifier) {
+  levels = classifier;
+  levelEvent = false;
+}
+
+bool TemperatureSensor::levelChanged() {
+  if (!levelEvent) {
+    return false;
+  }
+  levelEvent = false;
+  return true;
+}
+
+uint8_t TemperatureSensor::getLevel() const {
+  return levels ? levels->getLevel() : BAND_UNKNOWN;
+}
+
+bool TemperatureSensor::startRead() {
+  if (!isReady()) {
+    return false;
+  }
+  return dht->startRead();
+}
+
+bool TemperatureSensor::poll() {
+  bool busy = dht->poll();
+  if (dht->resultReady()) {
+    read(); // frame is cached in the DHT, no second bus transaction
+    newResult = true;
+  }
+  return busy;
+}
+
+bool TemperatureSensor::resultReady() {
+  if (!newResult) {
+    return false;
+  }
+  newResult = false;
   return true;
 }
 
 float TemperatureSensor::getTemperature() const {
-  return lastTemp;
+  return (lastTemp == DHT_INVALID_DECI) ? NAN : lastTemp * 0.1;
 }
 
 float TemperatureSensor::getTemperatureF() const {
-  return (lastTemp * 9.0 / 5.0) + 32.0;
+  return (getTemperature() * 9.0 / 5.0) + 32.0;
 }
 
 float TemperatureSensor::getHumidity() const {
+  return (lastHumidity == DHT_INVALID_DECI) ? NAN : lastHumidity * 0.1;
+}
+
+unsigned long TemperatureSensor::getSampleTime() const {
+  return sampleTime;
+}
+
+int16_t TemperatureSensor::getTemperatureDeci() const {
+  return lastTemp;
+}
+
+int16_t TemperatureSensor::getTemperatureFDeci() const {
+  return DHT::convertDeciCtoF(lastTemp);
+}
+
+int16_t TemperatureSensor::getHumidityDeci() const {
   return lastHumidity;
 }
 
@@ -44,10 +166,22 @@ bool TemperatureSensor::isValid() const {
 }
 
 void TemperatureSensor::setThresholds(float high, float low) {
+  setThresholdsDeci(toDeci(high), toDeci(low));
+}
+
+void TemperatureSensor::setThresholdsDeci(int16_t high, int16_t low) {
   tempHigh = high;
   tempLow = low;
 }
 
+int16_t TemperatureSensor::getHighThresholdDeci() const {
+  return tempHigh;
+}
+
+int16_t TemperatureSensor::getLowThresholdDeci() const {
+  return tempLow;
+}
+
 bool TemperatureSensor::isAboveHighThreshold() const {
   return lastReadValid && (lastTemp >= tempHigh);
 }
@@ -57,7 +191,13 @@ bool TemperatureSensor::isBelowLowThreshold() const {
 }
 
 TemperatureSensor::TempLevel TemperatureSensor::getTemperatureLevel(float coolMax, float warmMax) const {
-  if (lastTemp < coolMax) {
+  return getTemperatureLevelDeci(toDeci(coolMax), toDeci(warmMax));
+}
+
+TemperatureSensor::TempLevel TemperatureSensor::getTemperatureLevelDeci(int16_t coolMax, int16_t warmMax) const {
+  if (lastTemp == DHT_INVALID_DECI) {
+    return TEMP_HOT; // no valid reading: fail safe, e.g. fan stays on
+  } else if (lastTemp < coolMax) {
     return TEMP_COOL;
   } else if (lastTemp < warmMax) {
     return TEMP_WARM;
@@ -3,11 +3,19 @@
 
 #include <Arduino.h>
 #include <DHT.h>
+#include "TemperatureHistory.h"
+#include "BandClassifier.h"
+
+#define TEMP_SENSOR_WARMUP_MS 2000  // DHT settling time after power-up
 
 /**
  * TemperatureSensor
  * Wrapper class for DHT11/DHT22 temperature and humidity sensors.
  * Provides convenient methods for reading, status checking, and threshold management.
+ *
+ * Readings, thresholds and levels are kept as integers in tenths
+ * (235 = 23.5 °C, 652 = 65.2 %RH), so the *Deci() methods use no floating
+ * point at all. The float methods are thin wrappers around them.
  * 
  * Hardware requirements:
  * - DHT11 or DHT22 sensor
@@ -30,25 +38,53 @@ class TemperatureSensor {
       TEMP_HOT
     };
 
+    enum Status {
+      STATUS_OK = 0,        // last read valid
+      STATUS_WARMING_UP,    // begin() less than TEMP_SENSOR_WARMUP_MS ago
+      STATUS_ERROR          // last read failed
+    };
+
   private:
     DHT* dht;
     uint8_t pin;
     uint8_t type;
-    float lastTemp;
-    float lastHumidity;
+    int16_t lastTemp;       // 0.1 °C
+    int16_t lastHumidity;   // 0.1 %RH
     bool lastReadValid;
+    bool newResult;       // async read finished, not yet collected
+    Status status;
+    bool begun;
+    bool warm;            // warm-up over (latched, so millis() may wrap)
+    unsigned long readyAt;
     
-    // Threshold values
-    float tempHigh;
-    float tempLow;
+    // Threshold values, 0.1 °C
+    int16_t tempHigh;
+    int16_t tempLow;
+
+    // Optional rolling statistics, fed with every new frame
+    TemperatureHistoryBase* tempHistory;
+    TemperatureHistoryBase* humidityHistory;
+    bool historyFed;
+    unsigned long historyTime;  // timestamp of the last frame added
+    unsigned long sampleTime;   // millis() when the current values were read
+
+    // Optional level classifier, fed with every new frame
+    BandClassifierBase* levels;
+    bool levelEvent;            // level changed, not yet collected
+
+    static int16_t toDeci(float value);
 
   public:
     /**
      * Constructor
      * @param dhtPin GPIO pin connected to DHT sensor DATA pin
      * @param dhtType Sensor type: DHT11 or DHT22
+     * @param capture DHT_CAPTURE_POLLING (default) or DHT_CAPTURE_HARDWARE
+     *                (RMT on ESP32, input capture on pin 8 of UNO/Nano;
+     *                interrupts stay enabled during the read)
      */
-    TemperatureSensor(uint8_t dhtPin, uint8_t dhtType = DHT11);
+    TemperatureSensor(uint8_t dhtPin, uint8_t dhtType = DHT11,
+                      DHTCapture capture = DHT_CAPTURE_POLLING);
 
     /**
      * Destructor
@@ -56,16 +92,86 @@ class TemperatureSensor {
     ~TemperatureSensor();
 
     /**
-     * Initialize sensor (call in setup())
+     * Initialize sensor (call in setup()). Returns at once; the sensor
+     * warms up for TEMP_SENSOR_WARMUP_MS in the background, so several
+     * sensors warm up in parallel. Reads before that return false with
+     * getStatus() == STATUS_WARMING_UP.
      */
     void begin();
 
+    /**
+     * Check whether the warm-up after begin() is over
+     * @return true once the sensor may be read
+     */
+    bool isReady();
+
+    /**
+     * Time left until the sensor may be read
+     * @return Milliseconds (0 = ready)
+     */
+    unsigned long msUntilReady();
+
+    /**
+     * Result of the last read() (or of the last non-blocking read)
+     * @return STATUS_OK, STATUS_WARMING_UP or STATUS_ERROR
+     */
+    Status getStatus() const;
+
     /**
      * Read temperature and humidity
-     * @return true if read successful, false if error
+     * @return true if read successful, false if error or still warming up
      */
     bool read();
 
+    /**
+     * Start a non-blocking read (the DHT start pulse is timed by poll())
+     * @return true if started, false if busy, warming up or read less
+     *         than 2 s ago
+     */
+    bool startRead();
+
+    /**
+     * Advance a non-blocking read (call every loop())
+     * @return true while the read is in progress
+     */
+    bool poll();
+
+    /**
+     * Check once whether a non-blocking read has finished; the getters
+     * then return the new values (check isValid() for errors)
+     * @return true once per completed read
+     */
+    bool resultReady();
+
+    /**
+     * Keep rolling statistics of the readings. Each new frame from the
+     * sensor is added once (repeated read() calls within the sensor's 2 s
+     * interval return the cached frame and are not added again).
+     * @param temperature History for temperature (0.1 °C), or nullptr
+     * @param humidity History for humidity (0.1 %RH), or nullptr
+     */
+    void attachHistory(TemperatureHistoryBase* temperature, TemperatureHistoryBase* humidity = nullptr);
+
+    /**
+     * Classify every new temperature frame into levels with hysteresis and
+     * dwell time (see BandClassifier). Use levelChanged() / getLevel()
+     * instead of getTemperatureLevel() to act only on transitions.
+     * @param classifier Level classifier, or nullptr
+     */
+    void attachLevels(BandClassifierBase* classifier);
+
+    /**
+     * Check once whether the level of the attached classifier changed
+     * @return true once per transition
+     */
+    bool levelChanged();
+
+    /**
+     * Level of the attached classifier
+     * @return 0..bands-1, or BAND_UNKNOWN (no classifier or no sample yet)
+     */
+    uint8_t getLevel() const;
+
     /**
      * Get last temperature reading in Celsius
      * @return Temperature in °C
@@ -84,6 +190,30 @@ class TemperatureSensor {
      */
     float getHumidity() const;
 
+    /**
+     * When the current values were received from the sensor
+     * @return millis() of the bus transaction (not of the read() call)
+     */
+    unsigned long getSampleTime() const;
+
+    /**
+     * Get last temperature reading in tenths of °C
+     * @return e.g. 235 for 23.5 °C (DHT_INVALID_DECI after a failed read)
+     */
+    int16_t getTemperatureDeci() const;
+
+    /**
+     * Get last temperature reading in tenths of °F
+     * @return e.g. 743 for 74.3 °F (DHT_INVALID_DECI after a failed read)
+     */
+    int16_t getTemperatureFDeci() const;
+
+    /**
+     * Get last humidity reading in tenths of %RH
+     * @return e.g. 652 for 65.2 %RH (DHT_INVALID_DECI after a failed read)
+     */
+    int16_t getHumidityDeci() const;
+
     /**
      * Check if last reading was valid
      * @return true if valid, false if error
@@ -97,6 +227,19 @@ class TemperatureSensor {
      */
     void setThresholds(float high, float low);
 
+    /**
+     * Set temperature thresholds in tenths of °C
+     * @param high Temperature to turn ON (e.g., 300 = 30.0°C)
+     * @param low Temperature to turn OFF (e.g., 280 = 28.0°C)
+     */
+    void setThresholdsDeci(int16_t high, int16_t low);
+
+    /**
+     * Get the thresholds in tenths of °C
+     */
+    int16_t getHighThresholdDeci() const;
+    int16_t getLowThresholdDeci() const;
+
     /**
      * Check if temperature exceeds high threshold
      * @return true if temp >= high threshold
@@ -110,13 +253,22 @@ class TemperatureSensor {
     bool isBelowLowThreshold() const;
 
     /**
-     * Get temperature level category
+     * Get temperature level category (hard thresholds on every call; see
+     * attachLevels() for a classifier with hysteresis)
      * @param coolMax Maximum temp for COOL (default 28°C)
      * @param warmMax Maximum temp for WARM (default 32°C)
      * @return TempLevel enum (COOL, WARM, or HOT)
      */
     TempLevel getTemperatureLevel(float coolMax = 28.0, float warmMax = 32.0) const;
 
+    /**
+     * Get temperature level category, limits in tenths of °C
+     * @param coolMax Maximum temp for COOL (default 280 = 28.0°C)
+     * @param warmMax Maximum temp for WARM (default 320 = 32.0°C)
+     * @return TempLevel enum (COOL, WARM, or HOT)
+     */
+    TempLevel getTemperatureLevelDeci(int16_t coolMax = 280, int16_t warmMax = 320) const;
+
     /**
      * Get temperature level as string
      * @param coolMax Maximum temp for COOL
@@ -0,0 +1,179 @@
+#include "TemperatureTrend.h"
+
+TemperatureTrendBase::TemperatureTrendBase(int16_t* valueBuf, unsigned long* timeBuf, uint8_t size, unsigned long windowMs)
+: values(valueBuf), times(timeBuf), capacity(size), window(windowMs) {
+  clear();
+}
+
+void TemperatureTrendBase::clear() {
+  count = 0;
+  first = 0;
+  lastTime = 0;
+  sampled = false;
+  sx = sy = sxy = sxx = 0;
+}
+
+void TemperatureTrendBase::setWindow(unsigned long windowMs) {
+  window = windowMs;
+  while (count > 0 && times[(first + count - 1) % capacity] - times[first] > window) {
+    removeOldest();
+  }
+}
+
+bool TemperatureTrendBase::update(TemperatureSensor& sensor) {
+  if (!sensor.isValid()) {
+    return false;
+  }
+  unsigned long t = sensor.getSampleTime();
+  if (sampled && t == lastTime) {
+    return false; // already added
+  }
+  lastTime = t;
+  sampled = true;
+  add(sensor.getTemperatureDeci(), t);
+  return true;
+}
+
+// Drop the oldest sample and shift x so the new oldest one is at 0:
+// Σ(x-d) = Σx - n·d, Σ(x-d)y = Σxy - d·Σy, Σ(x-d)² = Σx² - 2d·Σx + n·d²
+void TemperatureTrendBase::removeOldest() {
+  uint8_t old = first;
+  // x of the oldest sample is 0, so it only contributes to n and Σy
+  sy -= values[old];
+  count--;
+  first = (first + 1) % capacity;
+  if (count == 0) {
+    sx = sy = sxy = sxx = 0;
+    return;
+  }
+  int64_t d = times[first] - times[old];
+  sxx += count * d * d - 2 * d * sx;
+  sxy -= d * sy;
+  sx -= count * d;
+}
+
+void TemperatureTrendBase::add(int16_t value, unsigned long timeMs) {
+  if (count == capacity) {
+    removeOldest();
+  }
+  while (count > 0 && timeMs - times[first] > window) {
+    removeOldest();
+  }
+  uint8_t slot = (first + count) % capacity;
+  values[slot] = value;
+  times[slot] = timeMs;
+  count++;
+  int64_t x = timeMs - times[first];
+  sx += x;
+  sy += value;
+  sxy += x * value;
+  sxx += x * x;
+}
+
+unsigned long TemperatureTrendBase::getSpan() const {
+  return count ? times[(first + count - 1) % capacity] - times[first] : 0;
+}
+
+bool TemperatureTrendBase::isValid() const {
+  return count >= 3 && getSpan() >= TREND_MIN_SPAN_MS;
+}
+
+float TemperatureTrendBase::slopePerMs() const {
+  int64_t den = count * sxx - sx * sx;
+  if (den <= 0) {
+    return 0;
+  }
+  return (float)(count * sxy - sx * sy) / (float)den;
+}
+
+float TemperatureTrendBase::fitAt(long x) const {
+  float n = count;
+  return sy / n + slopePerMs() * (x - sx / n);
+}
+
+int16_t TemperatureTrendBase::getRateDeci() const {
+  if (!isValid()) {
+    return 0;
+  }
+  float rate = slopePerMs() * 60000.0f;
+  rate = constrain(rate, -32767.0f, 32767.0f);
+  return (int16_t)(rate < 0 ? rate - 0.5f : rate + 0.5f);
+}
+
+int16_t TemperatureTrendBase::getProjectedDeci(unsigned long timeMs) const {
+  if (!isValid()) {
+    return DHT_INVALID_DECI;
+  }
+  float y = fitAt((long)(timeMs - times[first]));
+  y = constrain(y, -32767.0f, 32767.0f);
+  return (int16_t)(y < 0 ? y - 0.5f : y + 0.5f);
+}
+
+float TemperatureTrendBase::getProjected(unsigned long timeMs) const {
+  if (!isValid()) {
+    return NAN;
+  }
+  return fitAt((long)(timeMs - times[first])) * 0.1f;
+}
+
+unsigned long TemperatureTrendBase::timeToReachDeci(int16_t deci) const {
+  if (!isValid()) {
+    return TREND_NEVER;
+  }
+  float slope = slopePerMs();
+  if (slope == 0) {
+    return TREND_NEVER;
+  }
+  float ms = (deci - fitAt((long)(millis() - times[first]))) / slope;
+  if (ms < 0 || ms >= 4.0e9f) {
+    return TREND_NEVER;
+  }
+  return (unsigned long)ms;
+}
+
+unsigned long TemperatureTrendBase::timeToReach(float temperature) const {
+  return timeToReachDeci((int16_t)(temperature * 10.0f + (temperature < 0 ? -0.5f : 0.5f)));
+}
+
+bool TemperatureTrendBase::isRisingFasterThanDeci(int16_t perMinute) const {
+  return isValid() && getRateDeci() > perMinute;
+}
+
+bool TemperatureTrendBase::isRisingFasterThan(float perMinute) const {
+  return isValid() && slopePerMs() * 6000.0f > perMinute;
+}
+
+bool TemperatureTrendBase::isFallingFasterThanDeci(int16_t perMinute) const {
+  return isValid() && getRateDeci() < -perMinute;
+}
+
+bool TemperatureTrendBase::isFallingFasterThan(float perMinute) const {
+  return isValid() && slopePerMs() * 6000.0f < -perMinute;
+}
+
+// The line is monotonic, so checking both ends of the interval is enough
+bool TemperatureTrendBase::reaches(float deci, unsigned long withinMs, bool above) const {
+  if (!isValid()) {
+    return false;
+  }
+  long now = (long)(millis() - times[first]);
+  float a = fitAt(now);
+  float b = fitAt(now + (long)withinMs);
+  return above ? (a >= deci || b >= deci) : (a <= deci || b <= deci);
+}
+
+bool TemperatureTrendBase::willExceed(float limit, unsigned long withinMs) const {
+  return reaches(limit * 10.0f, withinMs, true);
+}
+
+bool TemperatureTrendBase::willExceedDeci(int16_t limit, unsigned long withinMs) const {
+  return reaches(limit, withinMs, true);
+}
+
+bool TemperatureTrendBase::willDropBelow(float limit, unsigned long withinMs) const {
+  return reaches(limit * 10.0f, withinMs, false);
+}
+
+bool TemperatureTrendBase::willDropBelowDeci(int16_t limit, unsigned long withinMs) const {
+  return reaches(limit, withinMs, false);
+}
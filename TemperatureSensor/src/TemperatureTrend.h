@@ -0,0 +1,159 @@
+#ifndef TEMPERATURE_TREND_H
+#define TEMPERATURE_TREND_H
+
+#include <Arduino.h>
+#include "TemperatureSensor.h"
+
+#define TREND_NEVER 0xFFFFFFFFUL    // timeToReach(): not heading there
+#define TREND_MIN_SPAN_MS 10000     // shorter windows give no usable slope
+
+/**
+ * TemperatureTrendBase
+ * Least-squares line through the samples of a sliding time window, for
+ * alarms on the rate of change ("rising faster than 2 °C/min") and on the
+ * projected value ("will reach 40 °C within 5 min"). Declare a
+ * TemperatureTrend<N> instead; this base holds the code for all N.
+ *
+ * The fit is kept as running sums (n, Σx, Σy, Σxy, Σx²) that are updated
+ * when a sample enters or leaves the window, so every query is O(1) and
+ * can run each tick. Times are in ms relative to the oldest sample; when
+ * it leaves, the sums are shifted to the new oldest one exactly (64-bit
+ * integers, no drift). Windows up to about an hour fit in the sums.
+ *
+ * The rate and projections are only reported once the window holds at
+ * least 3 samples spanning TREND_MIN_SPAN_MS (isValid()); before that the
+ * alarms stay off.
+ */
+class TemperatureTrendBase {
+  private:
+    int16_t* values;          // ring buffer, 0.1 °C
+    unsigned long* times;     // millis() of each sample
+    uint8_t capacity;
+    uint8_t count;
+    uint8_t first;            // ring position of the oldest sample
+    unsigned long window;     // ms
+    unsigned long lastTime;   // sensor timestamp already added
+    bool sampled;
+    int64_t sx, sy, sxy, sxx; // x = ms since times[first], y = 0.1 °C
+
+    void removeOldest();
+    float slopePerMs() const;   // 0.1 °C per ms
+    float fitAt(long x) const;  // 0.1 °C on the line at x
+    bool reaches(float deci, unsigned long withinMs, bool above) const;
+
+  protected:
+    TemperatureTrendBase(int16_t* valueBuf, unsigned long* timeBuf, uint8_t size, unsigned long windowMs);
+
+  public:
+    /**
+     * Add the sensor's latest reading if it is new and valid
+     * (call after read() / resultReady(); no bus access)
+     * @return true if a sample was added
+     */
+    bool update(TemperatureSensor& sensor);
+
+    /**
+     * Add a sample; samples older than the window are dropped, and the
+     * oldest one when the buffer is full
+     * @param value Value in tenths (0.1 °C)
+     * @param timeMs millis() when it was measured (not decreasing)
+     */
+    void add(int16_t value, unsigned long timeMs);
+
+    /**
+     * Forget all samples
+     */
+    void clear();
+
+    /**
+     * Set the window length (drops samples that no longer fit)
+     * @param windowMs e.g. 120000 for the last 2 minutes
+     */
+    void setWindow(unsigned long windowMs);
+
+    uint8_t size() const { return count; }
+
+    /**
+     * Time covered by the samples in the window
+     * @return ms from the oldest to the newest sample
+     */
+    unsigned long getSpan() const;
+
+    /**
+     * Check whether there are enough samples for a slope
+     */
+    bool isValid() const;
+
+    /**
+     * Slope of the fitted line
+     * @return Tenths of °C per minute (0 if not valid)
+     */
+    int16_t getRateDeci() const;
+    float getRate() const { return getRateDeci() * 0.1; }
+
+    /**
+     * Value of the fitted line at a time (past, now or future)
+     * @param timeMs millis() time
+     * @return Tenths of °C (DHT_INVALID_DECI if not valid)
+     */
+    int16_t getProjectedDeci(unsigned long timeMs) const;
+    float getProjected(unsigned long timeMs) const;
+
+    /**
+     * Time until the fitted line reaches a value
+     * @param deci Target in tenths of °C
+     * @return ms from now, TREND_NEVER if the line is flat, moves away
+     *         from the target or is not valid
+     */
+    unsigned long timeToReachDeci(int16_t deci) const;
+    unsigned long timeToReach(float temperature) const;
+
+    /**
+     * Rate alarms
+     * @param perMinute Rate in °C/min (Deci: 0.1 °C/min)
+     */
+    bool isRisingFasterThan(float perMinute) const;
+    bool isRisingFasterThanDeci(int16_t perMinute) const;
+    bool isFallingFasterThan(float perMinute) const;
+    bool isFallingFasterThanDeci(int16_t perMinute) const;
+
+    /**
+     * Projection alarms: true if the fitted line is at or beyond the limit
+     * now or will be within the given time
+     * @param limit °C (Deci: 0.1 °C)
+     * @param withinMs Look-ahead in ms, e.g. 300000 for 5 minutes
+     */
+    bool willExceed(float limit, unsigned long withinMs) const;
+    bool willExceedDeci(int16_t limit, unsigned long withinMs) const;
+    bool willDropBelow(float limit, unsigned long withinMs) const;
+    bool willDropBelowDeci(int16_t limit, unsigned long withinMs) const;
+};
+
+/**
+ * TemperatureTrend
+ * Sliding-window regression over at most N samples.
+ * Memory: 6 bytes per sample.
+ *
+ * Usage:
+ *   TemperatureTrend<64> trend(120000);     // last 2 minutes
+ *   if (sensor.resultReady()) trend.update(sensor);
+ *   if (trend.isRisingFasterThan(2.0) || trend.willExceed(40.0, 300000)) ...
+ */
+template <uint8_t N>
+class TemperatureTrend : public TemperatureTrendBase {
+  private:
+    int16_t valueBuf[N];
+    unsigned long timeBuf[N];
+
+  public:
+    /**
+     * Constructor
+     * @param windowMs Window length (default 2 minutes)
+     */
+    TemperatureTrend(unsigned long windowMs = 120000)
+    : TemperatureTrendBase(valueBuf, timeBuf, N, windowMs) {
+      static_assert(N >= 3, "TemperatureTrend needs at least 3 samples");
+    }
+};
+
+#endif // TEMPERATURE_TREND_H
@@ -60,11 +60,14 @@
 
 #include <DHT.h>
 #include <Button.h>
+#include <GPIOShadow.h>
+#include <TemperatureTrend.h>
 
 // ==================== Configuration ====================
 #define DHTPIN 4
 #define DHTTYPE DHT22
 DHT dht(DHTPIN, DHTTYPE);
+TemperatureTrend<64> trend(120000);       // แนวโน้มอุณหภูมิ 2 นาทีล่าสุด
 
 // GPIO Pins
 int seg[8] = {14, 27, 26, 25, 33, 32, 23, 12};  // a-g+dp
@@ -106,7 +109,7 @@ volatile float g_hysteresis = 2.0;        // °C
 volatile bool g_fanState = false;
 volatile bool g_manualOverride = false;
 
-volatile bool g_warning = false;          // อุณหภูมิสูงเกินไป (>40°C)
+volatile bool g_warning = false;          // อุณหภูมิสูงเกินไป (>40°C หรือกำลังจะถึงใน 5 นาที)
 
 // Display
 int displayDigits[4] = {0,0,0,0};
@@ -235,8 +238,10 @@ void TaskSensor(void *pvParameters) {
       
       updateDisplay();
       
-      // ตรวจสอบ warning
-      g_warning = (t > 40.0);
+      // ตรวจสอบ warning: เกิน 40°C แล้ว, จะถึง 40°C ภายใน 5 นาที,
+      // หรือร้อนขึ้นเร็วกว่า 2°C/นาที (เช่น พัดลมเสีย) - เตือนก่อนเกิดเหตุ
+      trend.add((int16_t)lround(t * 10), millis());
+      g_warning = (t > 40.0) || trend.willExceed(40.0, 300000) || trend.isRisingFasterThan(2.0);
     }
     
     vTaskDelay(2000 / portTICK_PERIOD_MS);
@@ -291,21 +296,24 @@ void TaskLEDs(void *pvParameters) {
   Serial.println("[Task] LEDs started");
   
   while (1) {
+    // GPIOShadow::write() skips pins that already have the level,
+    // so re-applying the same state every 100 ms costs no GPIO writes
+
     // Power LED: เปิดเสมอ
-    digitalWrite(LED_POWER, HIGH);
+    GPIOShadow::write(LED_POWER, HIGH);
     
     // Fan LED: ตาม fanState
-    digitalWrite(LED_FAN, g_fanState ? HIGH : LOW);
+    GPIOShadow::write(LED_FAN, g_fanState ? HIGH : LOW);
     
     // Warning LED: กระพริบเมื่อ warning
     if (g_warning) {
-      digitalWrite(LED_WARN, (millis() / 500) % 2);  // กระพริบทุก 500ms
+      GPIOShadow::write(LED_WARN, (millis() / 500) % 2);  // กระพริบทุก 500ms
     } else {
-      digitalWrite(LED_WARN, LOW);
+      GPIOShadow::write(LED_WARN, LOW);
     }
     
     // Manual LED: เปิดเมื่อโหมด Manual
-    digitalWrite(LED_MANUAL, !g_autoMode ? HIGH : LOW);
+    GPIOShadow::write(LED_MANUAL, !g_autoMode ? HIGH : LOW);
     
     vTaskDelay(100 / portTICK_PERIOD_MS);
   }
@@ -443,7 +451,7 @@ void loop() {
  * 
  * ==================== Safety Features ====================
  * 
- * 1. Warning LED กระพริบเมื่อ temp > 40°C
+ * 1. Warning LED กระพริบเมื่อ temp > 40°C หรือแนวโน้มจะถึง 40°C ภายใน 5 นาที
  * 2. Threshold จำกัด 20-40°C
  * 3. Hysteresis ป้องกัน relay สึก
  * 4. Serial logging สำหรับ debug